@@ -0,0 +1,102 @@
+// IntMatrixBenchmark.cpp
+
+/*
+ * -----------------------------------------------------------------------------
+ * This file contains a benchmark of the IntMatrix operations(+, *, trans and
+ * trace), its results can be compared with the ex3 generic Matrix benchmark.
+ * It uses a copy of the ex3 benchmark harness, see Benchmark.h for the command
+ * line options.
+ * -----------------------------------------------------------------------------
+ */
+
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "IntMatrix.h"
+
+const unsigned int BENCHMARK_SEED = 2015;
+const unsigned int MAX_MUL_SIZE = 1024;
+const std::vector<unsigned int> DEFAULT_SIZES = {64, 256, 1024};
+
+/**
+ * A function that creates a square matrix of random cells, the same for every run.
+ *
+ * @param size the number of rows and columns.
+ * @return the matrix.
+ */
+IntMatrix randomMatrix(const unsigned int size)
+{
+	std::mt19937 generator(BENCHMARK_SEED);
+	std::uniform_int_distribution<int> cells(-100, 100);
+	IntMatrix matrix(size, size);
+	for (unsigned int i = 0; i < size; i++)
+	{
+		for (unsigned int j = 0; j < size; j++)
+		{
+			matrix.setMatrixCell(i, j, cells(generator));
+		}
+	}
+	return matrix;
+}
+
+/**
+ * The main function, runs the benchmark and writes its results.
+ *
+ * @param argc the number of arguments.
+ * @param argv the arguments, see Benchmark.h.
+ * @return 0 on success, 1 in case of bad arguments.
+ */
+int main(int argc, char *argv[])
+{
+	BenchmarkOptions options;
+	try
+	{
+		options = parseBenchmarkOptions(argc, argv, DEFAULT_SIZES);
+	}
+	catch (std::exception &ex)
+	{
+		std::cerr << "Usage: IntMatrixBenchmark [--sizes n1,n2,...] [--samples n] [--warmup n] "
+					 "[--format csv|json] [--output file]\n" << ex.what() << std::endl;
+		return 1;
+	}
+
+	std::vector<BenchmarkResult> results;
+	for (unsigned int size : options.sizes)
+	{
+		IntMatrix left = randomMatrix(size);
+		IntMatrix right = left.trans();
+		double cells = static_cast<double>(size) * size;
+		BenchmarkResult result;
+		result.library = "IntMatrix";
+		result.type = "int";
+		result.mode = "sequential";
+		result.size = size;
+
+		result.operation = "+";
+		measure(options, [&]() { IntMatrix sum = left + right; }, cells, 3 * sizeof(int) * cells,
+				result);
+		results.push_back(result);
+
+		if (size <= MAX_MUL_SIZE)
+		{
+			result.operation = "*";
+			measure(options, [&]() { IntMatrix product = left * right; }, 2 * cells * size,
+					3 * sizeof(int) * cells, result);
+			results.push_back(result);
+		}
+
+		result.operation = "trans";
+		measure(options, [&]() { IntMatrix transposed = left.trans(); }, 0,
+				2 * sizeof(int) * cells, result);
+		results.push_back(result);
+
+		result.operation = "trace";
+		int trace = 0;
+		measure(options, [&]() { trace = left.trace(); }, size, sizeof(int) * size, result);
+		results.push_back(result);
+		std::cerr << "int sequential " << size << " done(trace " << trace << ")" << std::endl;
+	}
+	writeResults(options, results);
+	return 0;
+}
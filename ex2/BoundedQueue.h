@@ -0,0 +1,86 @@
+// BoundedQueue.h
+#ifndef BOUNDED_QUEUE_H_
+#define BOUNDED_QUEUE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+/**
+ * A class that represents a queue of a limited capacity shared between threads, pushing to a full
+ * queue waits for room and popping from an empty queue waits for an element. A closed queue
+ * accepts no more elements and the elements left in it are still popped.
+ */
+template<typename T>
+class BoundedQueue
+{
+	public:
+		/**
+		 * The default ctor used to create an empty queue.
+		 * @param capacity the maximal number of elements in the queue.
+		 */
+		explicit BoundedQueue(size_t capacity) : _capacity(capacity), _isClosed(false)
+		{
+		}
+
+		/**
+		 * A method that pushes an element to the end of the queue, it waits while the queue is
+		 * full.
+		 * @param element the element.
+		 * @return true iff the element was pushed, false in case the queue is closed.
+		 */
+		bool push(T &&element)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_notFull.wait(lock, [this]() { return _isClosed || _elements.size() < _capacity; });
+			if (_isClosed)
+			{
+				return false;
+			}
+			_elements.push_back(std::move(element));
+			_notEmpty.notify_one();
+			return true;
+		}
+
+		/**
+		 * A method that pops the element at the front of the queue, it waits while the queue is
+		 * empty and not closed.
+		 * @param element the element to move the popped element to.
+		 * @return true iff an element was popped, false in case the queue is closed and empty.
+		 */
+		bool pop(T &element)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_notEmpty.wait(lock, [this]() { return _isClosed || !_elements.empty(); });
+			if (_elements.empty())
+			{
+				return false;
+			}
+			element = std::move(_elements.front());
+			_elements.pop_front();
+			_notFull.notify_one();
+			return true;
+		}
+
+		/**
+		 * A method that closes the queue, the threads that wait for it are woken.
+		 */
+		void close()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_isClosed = true;
+			_notEmpty.notify_all();
+			_notFull.notify_all();
+		}
+
+	private:
+		size_t _capacity; /**< the maximal number of elements */
+		bool _isClosed; /**< true iff the queue is closed */
+		std::deque<T> _elements; /**< the elements, the front first */
+		std::mutex _mutex; /**< a mutex that guards the queue */
+		std::condition_variable _notFull; /**< signaled when an element is popped */
+		std::condition_variable _notEmpty; /**< signaled when an element is pushed */
+};
+
+#endif // BOUNDED_QUEUE_H_
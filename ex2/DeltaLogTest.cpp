@@ -0,0 +1,80 @@
+/*
+ * -----------------------------------------------------------------------------
+ * This file contains a test of the delta log parser, the log is written in
+ * pieces(as a writer appends to it while the server updates) and every change
+ * must be parsed only once it is complete.
+ * -----------------------------------------------------------------------------
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Parser.h"
+
+const std::string TEST_LOG_NAME = "DeltaLogTest.log";
+
+/**
+ * A function that appends a piece to the log.
+ * @param piece the text to append.
+ */
+void appendToLog(const std::string &piece)
+{
+	std::ofstream log(TEST_LOG_NAME.c_str(), std::ios::binary | std::ios::app);
+	log << piece;
+}
+
+/**
+ * A function that checks a condition of the test and reports it in case it fails.
+ * @param condition the condition.
+ * @param description the description of the condition.
+ * @return the condition.
+ */
+bool check(bool condition, const std::string &description)
+{
+	if (!condition)
+	{
+		std::cerr << "Failed: " << description << std::endl;
+	}
+	return condition;
+}
+
+/**
+ * The main function, writes the log in pieces and parses it after every piece.
+ * @return 0 iff all the checks passed.
+ */
+int main()
+{
+	std::remove(TEST_LOG_NAME.c_str());
+	SongArena arena;
+	std::vector<Parser::SongChange> changes;
+	size_t offset = 0;
+	bool isPassed = true;
+
+	// The last line of the song is written without its new line.
+	appendToLog("+\ntitle: PARTIAL\ntags: {rock 1}\ninstruments: {piano}\nperformedBy: Ba");
+	isPassed &= check(Parser::parseSongsDelta(TEST_LOG_NAME, offset, changes, arena) &&
+					  changes.empty() && offset == 0, "a half written line is not parsed");
+
+	// The song may still get a bpm line, so it is not complete until the next line.
+	appendToLog("nd Full\nbpm: 100\n");
+	isPassed &= check(Parser::parseSongsDelta(TEST_LOG_NAME, offset, changes, arena) &&
+					  changes.empty() && offset == 0, "an unterminated change is not parsed");
+
+	appendToLog(".\n-\ntitle: PARTIAL\n");
+	isPassed &= check(Parser::parseSongsDelta(TEST_LOG_NAME, offset, changes, arena) &&
+					  changes.size() == 1 && changes[0].addedSong != nullptr &&
+					  changes[0].addedSong->getCreator() == "performed by: Band Full" &&
+					  changes[0].addedSong->getBpm() == 100, "a terminated change is parsed");
+
+	appendToLog(".\n");
+	changes.clear();
+	isPassed &= check(Parser::parseSongsDelta(TEST_LOG_NAME, offset, changes, arena) &&
+					  changes.size() == 1 && changes[0].addedSong == nullptr &&
+					  changes[0].removedTitle == "PARTIAL", "the next change is parsed once");
+
+	std::remove(TEST_LOG_NAME.c_str());
+	std::cout << (isPassed ? "DeltaLogTest passed" : "DeltaLogTest failed") << std::endl;
+	return isPassed ? 0 : 1;
+}
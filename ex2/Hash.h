@@ -0,0 +1,51 @@
+// Hash.h
+#ifndef HASH_H_
+#define HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+const uint64_t FNV_PRIME = 1099511628211ull;
+
+/**
+ * A function that is used to hash bytes by the 64 bit FNV-1a hash, the hash of several buffers is
+ * calculated by passing the hash of the previous ones.
+ * @param data the bytes to hash.
+ * @param size the number of bytes.
+ * @param hash the hash of the previous bytes, FNV_OFFSET_BASIS for the first ones.
+ * @return the hash of the bytes.
+ */
+inline uint64_t hashBytes(const void *data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+	const unsigned char *bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; i++)
+	{
+		hash = (hash ^ bytes[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+/**
+ * A function that is used to hash a large buffer, it is hashed like hashBytes but 8 bytes at a
+ * time, which is faster and good enough to detect a corrupted file.
+ * @param data the bytes to hash.
+ * @param size the number of bytes.
+ * @param hash the hash of the previous bytes, FNV_OFFSET_BASIS for the first ones.
+ * @return the hash of the bytes.
+ */
+inline uint64_t hashWords(const void *data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+	const unsigned char *bytes = static_cast<const unsigned char*>(data);
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, bytes + i, sizeof(word));
+		hash = (hash ^ word) * FNV_PRIME;
+	}
+	return hashBytes(bytes + i, size - i, hash);
+}
+
+#endif // HASH_H_
@@ -3,6 +3,7 @@
  * This file contains the implementation of the Instrumental class methods
  * -----------------------------------------------------------------------
  */
+#include <algorithm>
 #include <set>
 #include "Instrumental.h"
 
@@ -10,16 +11,27 @@
 * The default ctor.
 * @param title the title of the song.
 * @param tagsValue the value of tags related to the song.
-* @param instruments instruments used to create the song.
+* @param instruments the ids of the instruments used to create the song.
 * @param performedBy the performer of the instrumental song.
 * @param bpm the beats per minute of the song.
 */
-Instrumental::Instrumental(const std::string &title, const std::map<std::string, int> &tagsValue,
-						   const std::set<std::string> &instruments, 
-						   const std::string &performedBy, int bpm) : Song::Song(title, tagsValue),
-						   _instruments(instruments), _performedBy(performedBy), _bpm(bpm)
+Instrumental::Instrumental(std::string_view title, TagsValue tagsValue, SongTerms instruments,
+						   std::string_view performedBy, int bpm) : 
+						   Song::Song(title, std::move(tagsValue)),
+						   _instruments(std::move(instruments)),
+						   _performedBy(performedBy, _instruments.get_allocator()), _bpm(bpm)
 {
-		
+	std::sort(_instruments.begin(), _instruments.end());
+	_instruments.erase(std::unique(_instruments.begin(), _instruments.end()), _instruments.end());
+}
+
+/**
+ * A method used to return the kind of the song.
+ * @return INSTRUMENTAL.
+ */
+SongKind Instrumental::getKind() const
+{
+	return INSTRUMENTAL;
 }
 
 /**
@@ -32,6 +44,36 @@ std::vector<std::string> Instrumental::getLyrics() const
 	return std::vector<std::string>();
 }
 
+/**
+ * A method used to return the ids of the lyrics words.
+ * @return an empty vector, no lyrics exist in an instrumental song.
+ */
+const SongTerms& Instrumental::getLyricsTerms() const
+{
+	static const SongTerms noLyrics;
+	return noLyrics;
+}
+
+/**
+ * A method used to return the number of times every word occures in the lyrics.
+ * @return an empty vector, no lyrics exist in an instrumental song.
+ */
+const WordsOccurence& Instrumental::getWordsOccurence() const
+{
+	static const WordsOccurence noWords;
+	return noWords;
+}
+
+/**
+ * A method used to return the number of times a word occures in the lyrics.
+ * @param word the id of the word.
+ * @return NO_SUCH_WORD, no lyrics exist in an instrumental song.
+ */
+int Instrumental::wordOccurence(TermId) const
+{
+	return NO_SUCH_WORD;
+}
+
 /**
 * A method that is used to determine if an instrument used at the creation of the song.
 * @param instrument the instrument to check.
@@ -39,7 +81,32 @@ std::vector<std::string> Instrumental::getLyrics() const
 */
 bool Instrumental::isInstrumentUsed(const std::string &instrument) const 
 {
-	return (_instruments.find(instrument) != _instruments.end());
+	return std::binary_search(_instruments.begin(), _instruments.end(),
+							  TermDictionary::getInstance().find(instrument));
+}
+
+/**
+* A method that returns the instruments used to create the song.
+* @return a set of the instruments.
+*/
+std::set<std::string> Instrumental::getInstruments() const
+{
+	std::set<std::string> instruments;
+	for (SongTerms::const_iterator it = _instruments.begin(); it != _instruments.end();
+		 ++it)
+	{
+		instruments.insert(TermDictionary::getInstance().getTerm(*it));
+	}
+	return instruments;
+}
+
+/**
+* A method that returns the ids of the instruments used to create the song.
+* @return a vector of the ids, sorted.
+*/
+const SongTerms& Instrumental::getInstrumentsTerms() const
+{
+	return _instruments;
 }
 
 
@@ -58,5 +125,5 @@ int Instrumental::getBpm() const
 */
 std::string Instrumental::getCreator() const
 {
-	return "performed by: " +  _performedBy;
+	return "performed by: " +  std::string(_performedBy);
 }
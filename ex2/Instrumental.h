@@ -14,14 +14,18 @@ class Instrumental : Song
 		 * The default ctor.
 		 * @param title the title of the song.
 		 * @param tagsValue the value of tags related to the song.
-		 * @param instruments instruments used to create the song.
+		 * @param instruments the ids of the instruments used to create the song.
 		 * @param performedBy the performer of the instrumental song.
 		 * @param bpm the beats per minute of the song.
 		 */
-		Instrumental(const std::string &title, 
-					 const std::map<std::string, int> &tagsValue,
-					 const std::set<std::string> &instruments, 
-					 const std::string &performedBy, int bpm = BPM_UNDEFINED);
+		Instrumental(std::string_view title, TagsValue tagsValue, SongTerms instruments,
+					 std::string_view performedBy, int bpm = BPM_UNDEFINED);
+
+		/**
+		 * A method used to return the kind of the song.
+		 * @return INSTRUMENTAL.
+		 */
+		SongKind getKind() const;
 
 		/**
 		 * A method used to return the lyrics of the song.
@@ -29,6 +33,25 @@ class Instrumental : Song
 		 */
 		std::vector<std::string> getLyrics() const;
 
+		/**
+		 * A method used to return the ids of the lyrics words.
+		 * @return an empty vector, no lyrics exist in an instrumental song.
+		 */
+		const SongTerms& getLyricsTerms() const;
+
+		/**
+		 * A method used to return the number of times every word occures in the lyrics.
+		 * @return an empty vector, no lyrics exist in an instrumental song.
+		 */
+		const WordsOccurence& getWordsOccurence() const;
+
+		/**
+		 * A method used to return the number of times a word occures in the lyrics.
+		 * @param word the id of the word.
+		 * @return NO_SUCH_WORD, no lyrics exist in an instrumental song.
+		 */
+		int wordOccurence(TermId word) const;
+
 		/**
 		 * A method that is used to determine if an instrument used at the creation of the song.
 		 * @param instrument the instrument to check.
@@ -36,6 +59,18 @@ class Instrumental : Song
 		 */
 		bool isInstrumentUsed(const std::string &instrument) const;
 
+		/**
+		 * A method that returns the instruments used to create the song.
+		 * @return a set of the instruments.
+		 */
+		std::set<std::string> getInstruments() const;
+
+		/**
+		 * A method that returns the ids of the instruments used to create the song.
+		 * @return a vector of the ids, sorted.
+		 */
+		const SongTerms& getInstrumentsTerms() const;
+
 		/**
 		 * A method that is used to get the beats per minute of the song.
 		 * @return the bpm of the song.
@@ -49,8 +84,9 @@ class Instrumental : Song
 		std::string getCreator() const;
 
 	private:
-		std::set<std::string> _instruments; /**< a set contains the instruments used in the song*/
-		std::string _performedBy; /**< a string contains the song performer name*/
+		SongTerms _instruments; /**< the sorted ids of the instruments used in the
+											song */
+		std::pmr::string _performedBy; /**< a string contains the song performer name*/
 		int _bpm; /**< the beats per minute of the song */
 };
 
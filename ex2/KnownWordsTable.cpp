@@ -0,0 +1,87 @@
+/*
+ * --------------------------------------------------------------------------
+ * This file contains the implementation of the KnownWordsTable class methods
+ * --------------------------------------------------------------------------
+ */
+#include <functional>
+#include "KnownWordsTable.h"
+
+const int EMPTY_SLOT = -1;
+// The table is kept at most half full, so the probe sequences are short.
+const size_t SLOTS_PER_WORD = 2;
+
+/**
+ * The default ctor used to build the table.
+ * @param knownWords a map between words and their average bpm and standard deviation.
+ */
+KnownWordsTable::KnownWordsTable(const std::map<std::string, std::pair<double, double> >
+								 &knownWords)
+{
+	size_t numOfSlots = 1;
+	while (numOfSlots < SLOTS_PER_WORD * knownWords.size())
+	{
+		numOfSlots *= 2;
+	}
+	_slots.assign(numOfSlots, EMPTY_SLOT);
+	_mask = numOfSlots - 1;
+
+	for (std::map<std::string, std::pair<double, double> >::const_iterator it = knownWords.begin();
+		 it != knownWords.end(); ++it)
+	{
+		KnownWord knownWord = {it->first, it->second.first, it->second.second, _words.size()};
+		size_t slot = _slot(knownWord.word);
+		while (_slots[slot] != EMPTY_SLOT)
+		{
+			slot = (slot + 1) & _mask;
+		}
+		_slots[slot] = _words.size();
+		_words.push_back(knownWord);
+	}
+}
+
+/**
+ * A method that looks a word up.
+ * @param word the word.
+ * @return a pointer to the known word, or nullptr in case the word is not known.
+ */
+const KnownWordsTable::KnownWord* KnownWordsTable::find(std::string_view word) const
+{
+	for (size_t slot = _slot(word); _slots[slot] != EMPTY_SLOT; slot = (slot + 1) & _mask)
+	{
+		const KnownWord &knownWord = _words[_slots[slot]];
+		if (knownWord.word == word)
+		{
+			return &knownWord;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * A method that returns the number of known words.
+ * @return the number of words.
+ */
+size_t KnownWordsTable::size() const
+{
+	return _words.size();
+}
+
+/**
+ * A method that returns a known word by its position.
+ * @param position the position of the word, less than size().
+ * @return the known word.
+ */
+const KnownWordsTable::KnownWord& KnownWordsTable::at(size_t position) const
+{
+	return _words[position];
+}
+
+/**
+ * A method that returns the first slot to probe for a word.
+ * @param word the word.
+ * @return the slot.
+ */
+size_t KnownWordsTable::_slot(std::string_view word) const
+{
+	return std::hash<std::string_view>()(word) & _mask;
+}
@@ -0,0 +1,71 @@
+// KnownWordsTable.h
+#ifndef KNOWN_WORDS_TABLE_H_
+#define KNOWN_WORDS_TABLE_H_
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * A class that represents the table of the known words and their bpm average and standard
+ * deviation. It is an open addressing hash table with linear probing, built once and then only
+ * read.
+ */
+class KnownWordsTable
+{
+	public:
+		/**
+		 * A struct that represents a known word.
+		 */
+		struct KnownWord
+		{
+			std::string word; /**< the word */
+			double average; /**< the average bpm of the word */
+			double standardDeviation; /**< the standard deviation of the bpm of the word */
+			size_t position; /**< the position of the word in the table, from 0 to size() */
+		};
+
+		/**
+		 * The default ctor used to build the table.
+		 * @param knownWords a map between words and their average bpm and standard deviation.
+		 */
+		explicit KnownWordsTable(const std::map<std::string, std::pair<double, double> >
+								 &knownWords);
+
+		/**
+		 * A method that looks a word up.
+		 * @param word the word.
+		 * @return a pointer to the known word, or nullptr in case the word is not known.
+		 */
+		const KnownWord* find(std::string_view word) const;
+
+		/**
+		 * A method that returns the number of known words.
+		 * @return the number of words.
+		 */
+		size_t size() const;
+
+		/**
+		 * A method that returns a known word by its position.
+		 * @param position the position of the word, less than size().
+		 * @return the known word.
+		 */
+		const KnownWord& at(size_t position) const;
+
+	private:
+		/**
+		 * A method that returns the first slot to probe for a word.
+		 * @param word the word.
+		 * @return the slot.
+		 */
+		size_t _slot(std::string_view word) const;
+
+		std::vector<KnownWord> _words; /**< the known words */
+		std::vector<int> _slots; /**< the position of the word in every slot, or EMPTY_SLOT, the
+								   number of slots is a power of two */
+		size_t _mask; /**< the number of slots minus one */
+};
+
+#endif // KNOWN_WORDS_TABLE_H_
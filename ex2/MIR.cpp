@@ -11,14 +11,70 @@
 #include <string>
 #include <map>
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
 #include "Song.h"
 #include "Scorer.h"
 #include "Parser.h"
+#include "Query.h"
+#include "QueryServer.h"
+#include "ResultCache.h"
+#include "SongCatalog.h"
+#include "Snapshot.h"
+#include "SongIndex.h"
+#include "UpdateMutex.h"
 
-const int SONGS_FILE_ARG_NUM = 1;
-const int PARAMETERS_FILE_ARG_NUM = 2;
-const int QUERIES_FILE_ARG_NUM = 3;
-const int LEGAL_NUM_OF_ARGS = 4;
+// The files are the last arguments, after the options, the server has no queries file.
+const int NUM_OF_FILE_ARGS = 3;
+const int NUM_OF_SERVER_FILE_ARGS = 2;
+const int NUM_OF_SNAPSHOT_FILE_ARGS = 1;
+const int SONGS_FILE_ARG_NUM = 0;
+const int PARAMETERS_FILE_ARG_NUM = 1;
+const int QUERIES_FILE_ARG_NUM = 2;
+const std::string BATCH_OPTION = "--batch";
+const std::string THREADS_OPTION = "--threads";
+const std::string TOP_OPTION = "--top";
+const std::string CACHE_OPTION = "--cache";
+const std::string CACHE_FILE_OPTION = "--cache-file";
+const std::string SERVE_OPTION = "--serve";
+const std::string SOCKET_OPTION = "--socket";
+const std::string DELTA_OPTION = "--delta";
+const std::string BUILD_SNAPSHOT_OPTION = "--build-snapshot";
+// A request of the server that applies the changes appended to the delta log.
+const std::string UPDATE_REQUEST = "!update";
+const std::string OPTION_PREFIX = "--";
+const size_t SERVER_QUEUE_CAPACITY = 1024;
+const size_t NO_CACHE = 0;
+const size_t DEFAULT_CACHE_MEGABYTES = 64;
+const size_t MEGABYTE = 1 << 20;
+const unsigned int ALL_RESULTS = 0;
+const unsigned int MIN_NUM_OF_THREADS = 1;
+const unsigned int BATCH_BLOCK_SIZE = 4096;
+
+/**
+ * A struct that holds the command line options.
+ */
+struct MirOptions
+{
+	bool batch; /**< true iff the queries are read at once and answered by several threads */
+	unsigned int threads; /**< the number of threads that parse the songs and answer the batch */
+	unsigned int top; /**< the number of results to write for each query, or ALL_RESULTS */
+	size_t cacheBudget; /**< the memory budget of the results cache in bytes, or NO_CACHE */
+	std::string cacheFile; /**< the file the cache is loaded from and saved to, or empty */
+	bool serve; /**< true iff the queries are served instead of read from a file */
+	std::string socketPath; /**< the unix socket to serve, or empty for stdin and stdout */
+	std::string deltaFile; /**< the songs delta log applied to the songs file, or empty */
+	std::string snapshotFile; /**< the snapshot to build of the songs, or empty */
+	int firstFileArg; /**< the position of the first file argument */
+};
 
 /**
  * A comperator used to compare between scoredSongs for std::stable_sort usage.
@@ -26,47 +82,762 @@ const int LEGAL_NUM_OF_ARGS = 4;
  * @param secondScore the second score to compare.
  * @return true iff the first score is greater than the second one.
  */
-bool scoredSongsComperator(const std::pair<Song*, int> &firstScore, 
-						   const std::pair<Song*, int> &secondScore) 
+bool scoredSongsComperator(const ScoredSong &firstScore, const ScoredSong &secondScore) 
 {
-	return (firstScore.second > secondScore.second);
+	return (firstScore.score > secondScore.score);
 }
 
 /**
- * A function used to free all the songs allocated on the heap by the parser.
- * @param a vector contains the songs to free.
+ * A comperator that orders the scored songs like the stable sort of the songs by their score, a
+ * higher score first and the songs file order between equal scores.
+ * @param first the first scored song.
+ * @param second the second scored song.
+ * @return true iff the first scored song is ranked before the second one.
  */
-void freeSongs(std::vector<Song*> &songs)
+bool isRankedBefore(const ScoredSong &first, const ScoredSong &second)
 {
-	for (std::vector<Song*>::iterator it = songs.begin(); it != songs.end(); ++it)
-	{
-		delete (*it);
-	}
+	return (first.score > second.score) || 
+		   ((first.score == second.score) && (first.song < second.song));
 }
 
 
 /**
  * A function that is used to score songs by its match to a given query.
- * @param songs the songs to score.
+ * Only the songs the query appears at(by the index) and, in case the query is a known word, the
+ * songs that have a bpm can get a non zero score, so only them are scored. They are scored in the
+ * order of the catalog.
+ * @param catalog the songs to score.
+ * @param index the index of the songs.
  * @param scorer the scorer which defines what score each song should get.
- * @param query the query to get the score of.
+ * @param query the prepared query to get the score of.
  * @return a vector which contains songs and their score with regard to the query.
  */
-std::vector<std::pair<Song*, int> > getScores(const std::vector<Song*> &songs, const Scorer &scorer,
-											  const std::string &query)
+std::vector<ScoredSong> getScores(const SongCatalog &catalog, const SongIndex &index,
+								  const Scorer &scorer, const Scorer::PreparedQuery &query)
 {
-	std::vector<std::pair<Song*, int> > res;
-	for (std::vector<Song*>::const_iterator it = songs.begin(); it != songs.end(); ++it)
+	static const std::vector<unsigned int> noBpmSongs;
+	static const SongIndex::Posting noPosting = {0, NO_SUCH_TAG, NO_SUCH_WORD, false};
+	const std::vector<SongIndex::Posting> &postings = index.getPostings(query.term);
+	const std::vector<unsigned int> &bpmSongs = (query.knownWord != nullptr) ? index.getBpmSongs() :
+																				 noBpmSongs;
+
+	std::vector<ScoredSong> res;
+	std::vector<SongIndex::Posting>::const_iterator posting = postings.begin();
+	std::vector<unsigned int>::const_iterator bpmSong = bpmSongs.begin();
+	// Merge the postings with the bpm songs by the song position.
+	while (posting != postings.end() || bpmSong != bpmSongs.end())
 	{
+		unsigned int song;
 		int score;
-		if ((score = scorer.getScore(*(*it), query)))
+		if (bpmSong == bpmSongs.end() || (posting != postings.end() && posting->song <= *bpmSong))
+		{
+			song = posting->song;
+			score = scorer.getScore(*posting, catalog.getBpm(song), query);
+			if (bpmSong != bpmSongs.end() && *bpmSong == song)
+			{
+				++bpmSong;
+			}
+			++posting;
+		}
+		else
+		{
+			song = *bpmSong;
+			score = scorer.getScore(noPosting, catalog.getBpm(song), query);
+			++bpmSong;
+		}
+
+		if (score)
+		{
+			ScoredSong scoredSong = {song, score};
+			res.push_back(scoredSong);
+		}
+	}
+	return res;
+}
+
+/**
+ * A function that offers a scored song to the top results, the top results are a heap whose
+ * front is the lowest ranked of them.
+ * @param top the heap of the top results.
+ * @param k the number of top results.
+ * @param scoredSong the scored song to offer.
+ */
+void offerTopResult(std::vector<ScoredSong> &top, unsigned int k, const ScoredSong &scoredSong)
+{
+	if (top.size() < k)
+	{
+		top.push_back(scoredSong);
+		std::push_heap(top.begin(), top.end(), isRankedBefore);
+	}
+	else if (isRankedBefore(scoredSong, top.front()))
+	{
+		std::pop_heap(top.begin(), top.end(), isRankedBefore);
+		top.back() = scoredSong;
+		std::push_heap(top.begin(), top.end(), isRankedBefore);
+	}
+}
+
+/**
+ * A function that is used to get the k top scored songs of a query, ranked like the sorted
+ * result of getScores, by a bounded heap.
+ * The songs the query appears at are scored first. The other songs can only get the bpm score,
+ * so in case the heap is full with songs that scored more than the maximal bpm score they are
+ * not scored at all.
+ * @param catalog the songs to score.
+ * @param index the index of the songs.
+ * @param scorer the scorer which defines what score each song should get.
+ * @param query the prepared query to get the score of.
+ * @param k the number of songs to return.
+ * @return a vector which contains the top songs and their scores, sorted by rank.
+ */
+std::vector<ScoredSong> getTopScores(const SongCatalog &catalog, const SongIndex &index,
+									 const Scorer &scorer, const Scorer::PreparedQuery &query,
+									 unsigned int k)
+{
+	static const SongIndex::Posting noPosting = {0, NO_SUCH_TAG, NO_SUCH_WORD, false};
+	const std::vector<SongIndex::Posting> &postings = index.getPostings(query.term);
+	std::vector<ScoredSong> top;
+	top.reserve(k);
+
+	for (std::vector<SongIndex::Posting>::const_iterator it = postings.begin(); 
+		 it != postings.end(); ++it)
+	{
+		ScoredSong scoredSong = {it->song, scorer.getScore(*it, catalog.getBpm(it->song), query)};
+		if (scoredSong.score)
+		{
+			offerTopResult(top, k, scoredSong);
+		}
+	}
+
+	bool isBpmScoreRanked = (top.size() < k) || (top.front().score <= scorer.getMaxBpmScore());
+	if ((query.knownWord != nullptr) && isBpmScoreRanked)
+	{
+		const std::vector<unsigned int> &bpmSongs = index.getBpmSongs();
+		std::vector<SongIndex::Posting>::const_iterator posting = postings.begin();
+		for (std::vector<unsigned int>::const_iterator it = bpmSongs.begin(); 
+			 it != bpmSongs.end(); ++it)
+		{
+			// Skip the songs that were scored with their posting.
+			while (posting != postings.end() && posting->song < *it)
+			{
+				++posting;
+			}
+			if (posting != postings.end() && posting->song == *it)
+			{
+				continue;
+			}
+
+			ScoredSong scoredSong = {*it, scorer.getScore(noPosting, catalog.getBpm(*it), query)};
+			if (scoredSong.score)
+			{
+				offerTopResult(top, k, scoredSong);
+			}
+		}
+	}
+
+	std::sort_heap(top.begin(), top.end(), isRankedBefore);
+	return top;
+}
+
+/**
+ * A function that counts the occurences of phrases in the lyrics of a song, the lyrics are
+ * traversed once for all the phrases.
+ * @param lyrics the lyrics words of the song.
+ * @param phrases the words of the phrases, by the position of their clause.
+ * @param phrasesToCount the positions of the phrases to count.
+ * @param counts the number of occurences of every phrase, it is added to.
+ */
+void countPhrases(SongCatalog::Range<TermId> lyrics,
+				  const std::vector<std::vector<TermId> > &phrases,
+				  const std::vector<size_t> &phrasesToCount, std::vector<int> &counts)
+{
+	size_t numOfWords = lyrics.end() - lyrics.begin();
+	for (size_t position = 0; position < numOfWords; position++)
+	{
+		for (size_t phrase : phrasesToCount)
+		{
+			const std::vector<TermId> &words = phrases[phrase];
+			if (words.size() <= numOfWords - position &&
+				std::equal(words.begin(), words.end(), lyrics.begin() + position))
+			{
+				counts[phrase]++;
+			}
+		}
+	}
+}
+
+/**
+ * A function that is used to score songs by their match to a query of several clauses.
+ * The postings of all the words of the query(and the bpm songs, in case a word is a known word)
+ * are merged by the song position, so every song is visited once and all the clauses are scored
+ * from the postings of the song. A song gets the sum of the scores of its clauses in case it
+ * matches the query, a clause is matched by a non zero score.
+ * @param catalog the songs to score.
+ * @param index the index of the songs.
+ * @param scorer the scorer which defines what score each song should get.
+ * @param query the query to get the score of.
+ * @return a vector which contains the matching songs and their score, in the order of the catalog.
+ */
+std::vector<ScoredSong> getQueryScores(const SongCatalog &catalog, const SongIndex &index,
+									   const Scorer &scorer, const Query &query)
+{
+	static const std::vector<unsigned int> noBpmSongs;
+	static const SongIndex::Posting noPosting = {0, NO_SUCH_TAG, NO_SUCH_WORD, false};
+	const std::vector<Query::Clause> &clauses = query.getClauses();
+
+	// Every distinct term of the query is merged once, the clauses refer to their terms.
+	std::vector<TermId> terms;
+	std::vector<std::vector<size_t> > clauseTerms(clauses.size());
+	std::vector<std::vector<TermId> > phrases(clauses.size());
+	std::vector<Scorer::PreparedQuery> prepared(clauses.size());
+	bool hasKnownWord = false;
+	for (size_t clause = 0; clause < clauses.size(); clause++)
+	{
+		for (const std::string &word : clauses[clause].words)
+		{
+			TermId term = TermDictionary::getInstance().find(word);
+			size_t position = std::find(terms.begin(), terms.end(), term) - terms.begin();
+			if (position == terms.size())
+			{
+				terms.push_back(term);
+			}
+			clauseTerms[clause].push_back(position);
+			if (clauses[clause].isPhrase)
+			{
+				phrases[clause].push_back(term);
+			}
+		}
+		if (!clauses[clause].isPhrase)
+		{
+			prepared[clause] = scorer.prepareQuery(clauses[clause].words.front());
+			hasKnownWord = hasKnownWord || (prepared[clause].knownWord != nullptr);
+		}
+	}
+
+	std::vector<const std::vector<SongIndex::Posting>*> postings;
+	for (TermId term : terms)
+	{
+		postings.push_back(&index.getPostings(term));
+	}
+	const std::vector<unsigned int> &bpmSongs = hasKnownWord ? index.getBpmSongs() : noBpmSongs;
+	std::vector<size_t> nextPosting(terms.size(), 0);
+	std::vector<const SongIndex::Posting*> songPostings(terms.size());
+	size_t nextBpmSong = 0;
+	std::vector<size_t> phrasesToCount;
+	std::vector<int> phraseCounts(clauses.size());
+
+	std::vector<ScoredSong> res;
+	while (true)
+	{
+		// The next song is the first song of the merged lists that was not scored yet.
+		unsigned int song = UINT_MAX;
+		bool isMerged = true;
+		for (size_t term = 0; term < terms.size(); term++)
+		{
+			if (nextPosting[term] < postings[term]->size())
+			{
+				song = std::min(song, (*postings[term])[nextPosting[term]].song);
+				isMerged = false;
+			}
+		}
+		if (nextBpmSong < bpmSongs.size())
 		{
-			res.push_back(std::pair<Song*, int>(*it, score));
+			song = std::min(song, bpmSongs[nextBpmSong]);
+			isMerged = false;
+		}
+		if (isMerged)
+		{
+			break;
+		}
+
+		for (size_t term = 0; term < terms.size(); term++)
+		{
+			songPostings[term] = &noPosting;
+			if (nextPosting[term] < postings[term]->size() &&
+				(*postings[term])[nextPosting[term]].song == song)
+			{
+				songPostings[term] = &(*postings[term])[nextPosting[term]++];
+			}
+		}
+		if (nextBpmSong < bpmSongs.size() && bpmSongs[nextBpmSong] == song)
+		{
+			++nextBpmSong;
+		}
+
+		// A phrase can only occure in a song that has all of its words in the lyrics.
+		phrasesToCount.clear();
+		for (size_t clause = 0; clause < clauses.size(); clause++)
+		{
+			phraseCounts[clause] = 0;
+			bool isCandidate = clauses[clause].isPhrase;
+			for (size_t term : clauseTerms[clause])
+			{
+				isCandidate = isCandidate && (songPostings[term]->lyricsCount > 0);
+			}
+			if (isCandidate)
+			{
+				phrasesToCount.push_back(clause);
+			}
+		}
+		if (!phrasesToCount.empty())
+		{
+			countPhrases(catalog.getLyricsWords(song), phrases, phrasesToCount, phraseCounts);
+		}
+
+		int bpm = catalog.getBpm(song);
+		int score = 0;
+		uint64_t matchedClauses = 0;
+		for (size_t clause = 0; clause < clauses.size(); clause++)
+		{
+			int clauseScore = clauses[clause].isPhrase ?
+							  scorer.getPhraseScore(phraseCounts[clause]) :
+							  scorer.getScore(*songPostings[clauseTerms[clause].front()], bpm,
+											  prepared[clause]);
+			if (clauseScore)
+			{
+				matchedClauses |= static_cast<uint64_t>(1) << clause;
+			}
+			score += clauseScore;
+		}
+
+		if (score && query.isMatch(matchedClauses))
+		{
+			ScoredSong scoredSong = {song, score};
+			res.push_back(scoredSong);
 		}
 	}
 	return res;
 }
 
+/**
+ * A function that writes the result of a query, the songs that match the query sorted by their
+ * score.
+ * @param output the stream to write to.
+ * @param catalog the songs to score.
+ * @param index the index of the songs.
+ * @param scorer the scorer which defines what score each song should get.
+ * @param query the query to answer.
+ * @param top the number of songs to write, or ALL_RESULTS.
+ * @param cache the cache of the ranked songs of the queries, or nullptr.
+ */
+void answerQuery(std::ostream &output, const SongCatalog &catalog, const SongIndex &index,
+				 const Scorer &scorer, const std::string &query, unsigned int top,
+				 ResultCache *cache)
+{
+	std::vector<ScoredSong> scores;
+	if (cache == nullptr || !cache->find(query, top, scores))
+	{
+		Query parsed(query);
+		if (!parsed.isSingleWord())
+		{
+			std::vector<ScoredSong> matches = getQueryScores(catalog, index, scorer, parsed);
+			scores.clear();
+			if (top != ALL_RESULTS)
+			{
+				for (std::vector<ScoredSong>::const_iterator it = matches.begin();
+					 it != matches.end(); ++it)
+				{
+					offerTopResult(scores, top, *it);
+				}
+				std::sort_heap(scores.begin(), scores.end(), isRankedBefore);
+			}
+			else
+			{
+				scores.swap(matches);
+				std::stable_sort(scores.begin(), scores.end(), scoredSongsComperator);
+			}
+		}
+		else if (top != ALL_RESULTS)
+		{
+			Scorer::PreparedQuery prepared = scorer.prepareQuery(query);
+			scores = getTopScores(catalog, index, scorer, prepared, top);
+		}
+		else
+		{
+			// Get scores and stable sort the songs by their scores
+			Scorer::PreparedQuery prepared = scorer.prepareQuery(query);
+			scores = getScores(catalog, index, scorer, prepared);
+			std::stable_sort(scores.begin(), scores.end(), scoredSongsComperator);
+		}
+
+		if (cache != nullptr)
+		{
+			cache->insert(query, top, scores);
+		}
+	}
+
+	output << "----------------------------------------" << std::endl;
+	output << "Query word: " << query << "\n" << std::endl;
+	for (std::vector<ScoredSong>::iterator it = scores.begin(); it != scores.end(); ++it)
+	{
+		output << catalog.getTitle(it->song) << "\t" << it->score
+			   << "\t" << catalog.getCreator(it->song) << std::endl;	
+	}
+}
+
+/**
+ * A function that answers the queries in batch mode, the queries are answered in blocks of
+ * BATCH_BLOCK_SIZE queries, every block is shared between the threads(a query at a time) and
+ * then written in the order of the queries.
+ * @param queries the queries to answer.
+ * @param numOfThreads the number of threads to use.
+ * @param catalog the songs to score.
+ * @param index the index of the songs.
+ * @param scorer the scorer which defines what score each song should get.
+ * @param top the number of songs to write for each query, or ALL_RESULTS.
+ * @param cache the cache of the ranked songs of the queries, or nullptr.
+ */
+void answerQueries(const std::vector<std::string> &queries, unsigned int numOfThreads,
+				   const SongCatalog &catalog, const SongIndex &index, const Scorer &scorer,
+				   unsigned int top, ResultCache *cache)
+{
+	std::vector<std::string> answers;
+	for (size_t blockBegin = 0; blockBegin < queries.size(); blockBegin += BATCH_BLOCK_SIZE)
+	{
+		size_t blockEnd = std::min(queries.size(), blockBegin + BATCH_BLOCK_SIZE);
+		answers.assign(blockEnd - blockBegin, std::string());
+		std::atomic<size_t> nextQuery(blockBegin);
+
+		auto answerBlock = [&]()
+		{
+			for (size_t i = nextQuery++; i < blockEnd; i = nextQuery++)
+			{
+				std::ostringstream answer;
+				answerQuery(answer, catalog, index, scorer, queries[i], top, cache);
+				answers[i - blockBegin] = answer.str();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (unsigned int i = 1; i < numOfThreads; i++)
+		{
+			threads.push_back(std::thread(answerBlock));
+		}
+		answerBlock();
+		for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+		{
+			it->join();
+		}
+
+		for (std::vector<std::string>::const_iterator it = answers.begin(); it != answers.end();
+			 ++it)
+		{
+			std::cout << *it;
+		}
+	}
+	std::cout.flush();
+}
+
+/**
+ * A function that applies changes of the songs delta log to the catalog and its index, the added
+ * songs are appended to the catalog and the removed songs keep their positions, so the positions
+ * of the other songs, and their order between equal scores, do not change.
+ * @param changes the changes in the log order, the vector is cleared.
+ * @param catalog the songs to change.
+ * @param index the index of the songs.
+ */
+void applySongChanges(std::vector<Parser::SongChange> &changes, SongCatalog &catalog,
+					  SongIndex &index)
+{
+	for (std::vector<Parser::SongChange>::iterator it = changes.begin(); it != changes.end(); ++it)
+	{
+		if (it->addedSong != nullptr)
+		{
+			catalog.addSong(*it->addedSong);
+			index.addSong(catalog, catalog.size() - 1);
+			continue;
+		}
+
+		std::vector<unsigned int> removedSongs = catalog.findSongs(it->removedTitle);
+		for (unsigned int song : removedSongs)
+		{
+			index.removeSong(catalog, song);
+			catalog.removeSong(song);
+		}
+	}
+	changes.clear();
+}
+
+/**
+ * A function that applies the changes appended to the songs delta log since the last update, the
+ * cached results are dropped in case the catalog changed.
+ * @param deltaFilename the delta log file name.
+ * @param offset the position of the first change not applied yet, it is advanced.
+ * @param catalog the songs to change.
+ * @param index the index of the songs.
+ * @param cache the cache of the ranked songs of the queries, or nullptr.
+ * @param numOfChanges the number of applied changes.
+ * @return true iff the log was read and its records are changes.
+ */
+bool updateCatalog(const std::string &deltaFilename, size_t &offset, SongCatalog &catalog,
+				   SongIndex &index, ResultCache *cache, size_t &numOfChanges)
+{
+	SongArena arena;
+	std::vector<Parser::SongChange> changes;
+	bool isParsed = Parser::parseSongsDelta(deltaFilename, offset, changes, arena);
+	numOfChanges = changes.size();
+	applySongChanges(changes, catalog, index);
+	if (cache != nullptr && numOfChanges != 0)
+	{
+		cache->invalidate(catalog.getVersion(), catalog.size());
+	}
+	return isParsed;
+}
+
+/**
+ * A function that loads the songs, of a songs file or of a snapshot of one, and applies the
+ * changes of the delta log to them.
+ * A snapshot is mapped and its catalog and index are copied out of it, so nothing is parsed or
+ * built. It includes the changes applied before it was built, so the delta log should only hold
+ * the changes made after it.
+ * @param songsFilename the songs file name, or the snapshot file name.
+ * @param options the command line options.
+ * @param catalog the catalog to load the songs to.
+ * @param index the index to load the index of the songs to.
+ * @param deltaOffset the position of the first change of the delta log not applied yet.
+ * @return true iff the songs were loaded.
+ */
+bool loadSongs(const std::string &songsFilename, const MirOptions &options, SongCatalog &catalog,
+			   SongIndex &index, size_t &deltaOffset)
+{
+	if (SnapshotReader::isSnapshot(songsFilename))
+	{
+		SnapshotReader snapshot;
+		if (!snapshot.open(songsFilename) || !TermDictionary::getInstance().load(snapshot) ||
+			!catalog.load(snapshot) || !index.load(snapshot) || !snapshot.isEnded())
+		{
+			std::cerr << "Error! Bad snapshot file: " << songsFilename << "." << std::endl;
+			return false;
+		}
+	}
+	else
+	{
+		// The songs are kept as a catalog, the song objects are released with their arena after
+		// it is built.
+		SongArena arena;
+		std::vector<Song*> songs;
+		if (!Parser::parseSongs(songsFilename, songs, arena, options.threads))
+		{
+			return false;
+		}
+		catalog = SongCatalog(songs);
+		index = SongIndex(catalog);
+	}
+
+	// The songs file is the base snapshot, the changes of the delta log are applied to it.
+	size_t numOfChanges = 0;
+	return options.deltaFile.empty() ||
+		   updateCatalog(options.deltaFile, deltaOffset, catalog, index, nullptr, numOfChanges);
+}
+
+/**
+ * A function that writes a snapshot of the songs, the terms, the catalog and the index.
+ * @param snapshotFilename the snapshot file name.
+ * @param catalog the songs.
+ * @param index the index of the songs.
+ * @return true iff the snapshot was written.
+ */
+bool buildSnapshot(const std::string &snapshotFilename, const SongCatalog &catalog,
+				   const SongIndex &index)
+{
+	SnapshotWriter snapshot;
+	TermDictionary::getInstance().save(snapshot);
+	catalog.save(snapshot);
+	index.save(snapshot);
+	if (!snapshot.save(snapshotFilename))
+	{
+		std::cerr << "Error! Can't write file: " << snapshotFilename << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * A function that answers the queries of a queries file, one by one or in batch mode.
+ * @param queriesFilename the queries file name.
+ * @param options the command line options.
+ * @param catalog the songs to score.
+ * @param index the index of the songs.
+ * @param scorer the scorer which defines what score each song should get.
+ * @param cache the cache of the ranked songs of the queries, or nullptr.
+ * @return true iff the queries file was read.
+ */
+bool answerQueriesFile(const std::string &queriesFilename, const MirOptions &options,
+					   const SongCatalog &catalog, const SongIndex &index, const Scorer &scorer,
+					   ResultCache *cache)
+{
+	std::ifstream instream(queriesFilename.c_str());
+	if (!instream.is_open())
+	{
+		std::cerr << "Error! Can't open file: " << queriesFilename << "." << std::endl;	
+		return false;
+	}
+
+	std::string query;
+	std::vector<std::string> queries;
+	Parser::getlineSkipEmpty(instream, query);
+
+	while(instream.good())
+	{
+		if (options.batch)
+		{
+			queries.push_back(query);
+		}
+		else
+		{
+			answerQuery(std::cout, catalog, index, scorer, query, options.top, cache);
+		}
+		Parser::getlineSkipEmpty(instream, query);
+	}
+
+	if (options.batch)
+	{
+		answerQueries(queries, options.threads, catalog, index, scorer, options.top, cache);
+	}
+	return true;
+}
+
+/**
+ * A function that serves the queries of the standard input or of a unix socket, until the
+ * standard input ends. Every query is a line and its answer is followed by an END_OF_ANSWER line.
+ * An UPDATE_REQUEST line applies the changes appended to the delta log, the queries are answered
+ * concurrently and an update waits for the queries being answered and blocks the next ones, the
+ * mutex prefers the update so it is not starved by a steady load of queries.
+ * @param options the command line options.
+ * @param catalog the songs to score.
+ * @param index the index of the songs.
+ * @param scorer the scorer which defines what score each song should get.
+ * @param cache the cache of the ranked songs of the queries, or nullptr.
+ * @param deltaOffset the position of the first change of the delta log not applied yet.
+ * @return true iff the standard input was served to its end.
+ */
+bool serveQueries(const MirOptions &options, SongCatalog &catalog, SongIndex &index,
+				  const Scorer &scorer, ResultCache *cache, size_t deltaOffset)
+{
+	UpdateMutex catalogMutex;
+	QueryServer server([&](const std::string &query)
+	{
+		std::ostringstream answer;
+		if (query == UPDATE_REQUEST)
+		{
+			std::unique_lock<UpdateMutex> lock(catalogMutex);
+			size_t numOfChanges = 0;
+			if (options.deltaFile.empty() ||
+				!updateCatalog(options.deltaFile, deltaOffset, catalog, index, cache, numOfChanges))
+			{
+				throw std::runtime_error("Can't update the songs by the delta log.");
+			}
+			answer << "Applied changes: " << numOfChanges << std::endl;
+			return answer.str();
+		}
+
+		std::shared_lock<UpdateMutex> lock(catalogMutex);
+		answerQuery(answer, catalog, index, scorer, query, options.top, cache);
+		return answer.str();
+	}, options.threads, SERVER_QUEUE_CAPACITY);
+
+	if (!options.socketPath.empty())
+	{
+		return server.serveSocket(options.socketPath);
+	}
+	server.serveStream(STDIN_FILENO, STDOUT_FILENO);
+	return true;
+}
+
+/**
+ * A function that parses the options given before the files names.
+ * @param argc the number of arguments given from cli.
+ * @param argv the arguments was given by the cli.
+ * @param options the options to fill.
+ * @return true iff the options are legal.
+ */
+bool parseOptions(int argc, char *argv[], MirOptions &options)
+{
+	options.batch = false;
+	options.top = ALL_RESULTS;
+	options.cacheBudget = NO_CACHE;
+	options.serve = false;
+	options.threads = std::max(MIN_NUM_OF_THREADS, std::thread::hardware_concurrency());
+
+	int i = 1;
+	for (; i < argc && std::string(argv[i]).compare(0, OPTION_PREFIX.size(), OPTION_PREFIX) == 0;
+		 i++)
+	{
+		if (argv[i] == BATCH_OPTION)
+		{
+			options.batch = true;
+		}
+		else if (argv[i] == THREADS_OPTION && i + 1 < argc)
+		{
+			int threads = std::atoi(argv[++i]);
+			if (threads < static_cast<int>(MIN_NUM_OF_THREADS))
+			{
+				return false;
+			}
+			options.threads = threads;
+		}
+		else if (argv[i] == TOP_OPTION && i + 1 < argc)
+		{
+			int top = std::atoi(argv[++i]);
+			if (top <= 0)
+			{
+				return false;
+			}
+			options.top = top;
+		}
+		else if (argv[i] == CACHE_OPTION && i + 1 < argc)
+		{
+			int megabytes = std::atoi(argv[++i]);
+			if (megabytes <= 0)
+			{
+				return false;
+			}
+			options.cacheBudget = megabytes * MEGABYTE;
+		}
+		else if (argv[i] == CACHE_FILE_OPTION && i + 1 < argc)
+		{
+			options.cacheFile = argv[++i];
+		}
+		else if (argv[i] == DELTA_OPTION && i + 1 < argc)
+		{
+			options.deltaFile = argv[++i];
+		}
+		else if (argv[i] == BUILD_SNAPSHOT_OPTION && i + 1 < argc)
+		{
+			options.snapshotFile = argv[++i];
+		}
+		else if (argv[i] == SERVE_OPTION)
+		{
+			options.serve = true;
+		}
+		else if (argv[i] == SOCKET_OPTION && i + 1 < argc)
+		{
+			options.serve = true;
+			options.socketPath = argv[++i];
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	options.firstFileArg = i;
+	int numOfFileArgs = options.serve ? NUM_OF_SERVER_FILE_ARGS : NUM_OF_FILE_ARGS;
+	if (!options.snapshotFile.empty())
+	{
+		numOfFileArgs = NUM_OF_SNAPSHOT_FILE_ARGS;
+	}
+	if (argc - i != numOfFileArgs)
+	{
+		return false;
+	}
+	if (!options.cacheFile.empty() && options.cacheBudget == NO_CACHE)
+	{
+		options.cacheBudget = DEFAULT_CACHE_MEGABYTES * MEGABYTE;
+	}
+	return true;
+}
+
 /**
  * The main function.
  * used to print all the songs match to a query by a given arguments.
@@ -75,57 +846,66 @@ std::vector<std::pair<Song*, int> > getScores(const std::vector<Song*> &songs, c
  */
 int main(int argc, char *argv[])
 {
-	if (argc != LEGAL_NUM_OF_ARGS)
+	MirOptions options;
+	if (!parseOptions(argc, argv, options))
 	{
-		std::cout << "Usage: MIR < songs file name > < parameters file name > < queries file name >"
-				  << std::endl;
+		std::cout << "Usage: MIR [--top < number of results >] "
+					 "[--threads < number of threads >] [--batch] "
+					 "[--cache < megabytes >] [--cache-file < cache file name >] "
+					 "[--delta < delta log name >] "
+					 "< songs file name > < parameters file name > < queries file name >\n"
+					 "       MIR [--top < number of results >] [--threads < number of threads >] "
+					 "[--cache < megabytes >] [--cache-file < cache file name >] "
+					 "[--delta < delta log name >] (--serve | --socket < socket path >) "
+					 "< songs file name > < parameters file name >\n"
+					 "       MIR [--threads < number of threads >] [--delta < delta log name >] "
+					 "--build-snapshot < snapshot file name > < songs file name >" << std::endl;
 		return 1;
 	}
-	// Declare on the relevant data structures for the songs parser.
-	std::string songsFilename(argv[SONGS_FILE_ARG_NUM]);
-	std::vector<Song*> songs;
+	char **files = argv + options.firstFileArg;
 
-	// Declare on the relevant data structures for the parameters parser.
-	std::string parametersFilename(argv[PARAMETERS_FILE_ARG_NUM]);
+	// Declare on the relevant data structures for the parameters parser, a snapshot is built
+	// without parameters.
 	std::map<Scorer::ScoreParameters, int> parametersValue;
 	std::map<std::string, std::pair<double, double> > knownWords;
+	SongCatalog catalog;
+	SongIndex index;
+	size_t deltaOffset = 0;
 
 	// Parse and check for file handeling problems.
-	if (!Parser::parseParameters(parametersFilename, parametersValue, knownWords) || 
-		!Parser::parseSongs(songsFilename, songs))
+	if ((options.snapshotFile.empty() && 
+		 !Parser::parseParameters(files[PARAMETERS_FILE_ARG_NUM], parametersValue, knownWords)) ||
+		!loadSongs(files[SONGS_FILE_ARG_NUM], options, catalog, index, deltaOffset))
 	{
 		return 1;
 	}
-
-	Scorer scorer(parametersValue, knownWords);
-			
-	std::ifstream instream(argv[QUERIES_FILE_ARG_NUM]);
-	if (!instream.is_open())
+	if (!options.snapshotFile.empty())
 	{
-		std::cerr << "Error! Can't open file: " << argv[QUERIES_FILE_ARG_NUM] << "." << std::endl;	
-		return 1;
+		return buildSnapshot(options.snapshotFile, catalog, index) ? 0 : 1;
 	}
+	Scorer scorer(parametersValue, knownWords);
+	scorer.prepareBpmScores(catalog.getMinBpm(), catalog.getMaxBpm(), index.getBpmSongs().size());
 
-	std::string query;
-	Parser::getlineSkipEmpty(instream, query);
-
-	while(instream.good())
+	std::unique_ptr<ResultCache> cache;
+	if (options.cacheBudget != NO_CACHE)
 	{
-		// Get scores and stable sort the songs by their scores
-		std::vector<std::pair<Song*, int> > scores = getScores(songs, scorer, query);
-		std::stable_sort(scores.begin(), scores.end(), scoredSongsComperator);
-
-		std::cout << "----------------------------------------" << std::endl;
-		std::cout << "Query word: " << query << "\n" << std::endl;
-		for (std::vector<std::pair<Song*, int> >::iterator it = scores.begin();
-			 it != scores.end(); ++it)
+		cache.reset(new ResultCache(options.cacheBudget, scorer.getParametersHash(),
+									catalog.getVersion(), catalog.size()));
+		if (!options.cacheFile.empty())
 		{
-			std::cout << it->first->getTitle() << "\t" << it->second
-					  << "\t" << it->first->getCreator() << std::endl;	
+			cache->load(options.cacheFile);
 		}
-		Parser::getlineSkipEmpty(instream, query);
+	}
+			
+	bool isAnswered = options.serve ? 
+					  serveQueries(options, catalog, index, scorer, cache.get(), deltaOffset) :
+					  answerQueriesFile(files[QUERIES_FILE_ARG_NUM], options, catalog, index,
+										scorer, cache.get());
+
+	if (cache && !options.cacheFile.empty() && !cache->save(options.cacheFile))
+	{
+		std::cerr << "Error! Can't write file: " << options.cacheFile << "." << std::endl;
 	}
 
-	freeSongs(songs);
-	return 0;
+	return isAnswered ? 0 : 1;
 }
@@ -0,0 +1,103 @@
+/*
+ * ---------------------------------------------------------------------
+ * This file contains the implementation of the MappedFile class methods
+ * ---------------------------------------------------------------------
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+
+/**
+ * The default ctor, creates an object that maps no file.
+ */
+MappedFile::MappedFile() : _data(nullptr), _size(0)
+{
+}
+
+/**
+ * The destructor, unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+	_close();
+}
+
+/**
+ * A method that maps a file, instead of the file mapped before.
+ * @param fileName the name of the file to map.
+ * @return true iff the file was opened and mapped.
+ */
+bool MappedFile::open(const std::string &fileName)
+{
+	_close();
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	// An empty file cannot be mapped, it is represented by an empty range.
+	if (fileStat.st_size > 0)
+	{
+		void *data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			::close(fd);
+			return false;
+		}
+		madvise(data, fileStat.st_size, MADV_SEQUENTIAL);
+		_data = static_cast<const char*>(data);
+		_size = fileStat.st_size;
+	}
+	::close(fd);
+	return true;
+}
+
+/**
+ * A method that returns the beginning of the file content.
+ * @return a pointer to the first byte of the file.
+ */
+const char* MappedFile::begin() const
+{
+	return _data;
+}
+
+/**
+ * A method that returns the end of the file content.
+ * @return a pointer past the last byte of the file.
+ */
+const char* MappedFile::end() const
+{
+	return _data + _size;
+}
+
+/**
+ * A method that returns the size of the file.
+ * @return the number of bytes in the file.
+ */
+size_t MappedFile::size() const
+{
+	return _size;
+}
+
+/**
+ * A method that unmaps the mapped file, if any.
+ */
+void MappedFile::_close()
+{
+	if (_data != nullptr)
+	{
+		munmap(const_cast<char*>(_data), _size);
+	}
+	_data = nullptr;
+	_size = 0;
+}
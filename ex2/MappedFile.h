@@ -0,0 +1,63 @@
+// MappedFile.h
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+/**
+ * A class that represents a file mapped read-only to the memory, the file is unmapped when the
+ * object is destroyed.
+ */
+class MappedFile
+{
+	public:
+		/**
+		 * The default ctor, creates an object that maps no file.
+		 */
+		MappedFile();
+
+		/**
+		 * The destructor, unmaps the file.
+		 */
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * A method that maps a file, instead of the file mapped before.
+		 * @param fileName the name of the file to map.
+		 * @return true iff the file was opened and mapped.
+		 */
+		bool open(const std::string &fileName);
+
+		/**
+		 * A method that returns the beginning of the file content.
+		 * @return a pointer to the first byte of the file.
+		 */
+		const char* begin() const;
+
+		/**
+		 * A method that returns the end of the file content.
+		 * @return a pointer past the last byte of the file.
+		 */
+		const char* end() const;
+
+		/**
+		 * A method that returns the size of the file.
+		 * @return the number of bytes in the file.
+		 */
+		size_t size() const;
+
+	private:
+		/**
+		 * A method that unmaps the mapped file, if any.
+		 */
+		void _close();
+
+		const char *_data; /**< the mapped content, nullptr for an empty file */
+		size_t _size; /**< the size of the mapped content */
+};
+
+#endif // MAPPED_FILE_H_
@@ -3,11 +3,20 @@
  * This file contains the parser module.
  * -----------------------------------------------------------------------------
  */
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <fstream>
 #include <string>
 #include <set>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include "MappedFile.h"
 #include "Parser.h"
 #include "Instrumental.h"
 #include "Vocal.h"
@@ -31,173 +40,471 @@ void Parser::getlineSkipEmpty(std::ifstream &instream, std::string &line)
 }
 
 /**
- * A function that is used to remove curly brackets surrounding text.
+ * A class that is used to read the lines of a songs file mapped to the memory, in a single
+ * forward pass. The lines are views of the mapped file, so they are valid as long as it is mapped.
+ */
+class SongsReader
+{
+	public:
+		/**
+		 * A ctor that creates a reader of the range [begin, end).
+		 * @param begin the beginning of the songs file content.
+		 * @param end the end of the songs file content.
+		 */
+		SongsReader(const char *begin, const char *end) : _position(begin), _end(end)
+		{
+		}
+
+		/**
+		 * A method that is used to read the next line, it skips empty lines like getlineSkipEmpty.
+		 * @param line the line to save to.
+		 * @return true iff a line was read, false if the file ended.
+		 */
+		bool nextLine(std::string_view &line)
+		{
+			if (!peekLine(line))
+			{
+				return false;
+			}
+			_position = line.data() + line.size();
+			if (_position != _end)
+			{
+				_position++;
+			}
+			return true;
+		}
+
+		/**
+		 * A method that is used to get the next line without reading it, it skips empty lines.
+		 * @param line the line to save to.
+		 * @return true iff there is a next line, false if the file ended.
+		 */
+		bool peekLine(std::string_view &line)
+		{
+			while (_position != _end && *_position == NEW_LINE)
+			{
+				_position++;
+			}
+			if (_position == _end)
+			{
+				return false;
+			}
+			const char *lineEnd = static_cast<const char*>(memchr(_position, NEW_LINE,
+																  _end - _position));
+			if (lineEnd == nullptr)
+			{
+				lineEnd = _end;
+			}
+			line = std::string_view(_position, lineEnd - _position);
+			return true;
+		}
+
+		/**
+		 * A method that returns the position of the reader.
+		 * @return the beginning of the next line to read, or of the empty lines before it.
+		 */
+		const char* position() const
+		{
+			return _position;
+		}
+
+	private:
+		const char *_position; /**< the beginning of the next line to read */
+		const char *_end; /**< the end of the file content */
+};
+
+/**
+ * A function that is used to get the text surrounded by curly brackets.
  * @param str the surounded string.
- * @return a copy of the string without the surounding brackets.
+ * @return a view of the string without the surounding brackets.
  */
-std::string removeReduntantBrackets(const std::string &str)
+std::string_view removeReduntantBrackets(std::string_view str)
 {
 	size_t pos1 = str.find_first_of(TAGS_OPEN_SYMBOL);
 	size_t pos2 = str.find_last_of(TAGS_CLOSE_SYMBOL);
 	return str.substr(pos1 + 1, (pos2 - pos1) - 1);
 }
 
+/**
+ * A function that is used to take the next white space separated word of a text, the way
+ * operator>> reads a string.
+ * @param text the text to read, the word and the spaces before it are removed from it.
+ * @param word the word to save to.
+ * @return true iff a word was read, false if the text has no more words.
+ */
+bool nextWord(std::string_view &text, std::string_view &word)
+{
+	size_t begin = 0;
+	while (begin < text.size() && isspace(static_cast<unsigned char>(text[begin])))
+	{
+		begin++;
+	}
+	size_t end = begin;
+	while (end < text.size() && !isspace(static_cast<unsigned char>(text[end])))
+	{
+		end++;
+	}
+	word = text.substr(begin, end - begin);
+	text.remove_prefix(end);
+	return !word.empty();
+}
+
+/**
+ * A function that is used to parse a tag value, the way operator>> reads a whole word as an int.
+ * @param word the value as a word.
+ * @param value the int to save to.
+ * @return true iff the word is an int.
+ */
+bool parseValue(std::string_view word, int &value)
+{
+	if (word.size() > 1 && word[0] == '+' && word[1] != '-')
+	{
+		word.remove_prefix(1);
+	}
+	std::from_chars_result result = std::from_chars(word.data(), word.data() + word.size(), value);
+	return result.ec == std::errc() && result.ptr == word.data() + word.size();
+}
+
+/**
+ * A class that is used to intern the terms of a part of the songs file, it keeps the ids of the
+ * terms it has seen, so the shared dictionary is locked only for the terms new to the part.
+ * The terms are views of the mapped file, so it should be used only while the file is mapped.
+ */
+class TermsCache
+{
+	public:
+		/**
+		 * A method that returns the id of a term, the term is interned in case it is new.
+		 * @param term the term.
+		 * @return the id of the term.
+		 */
+		TermId intern(std::string_view term)
+		{
+			std::unordered_map<std::string_view, TermId>::const_iterator it = _ids.find(term);
+			if (it != _ids.end())
+			{
+				return it->second;
+			}
+			TermId id = TermDictionary::getInstance().intern(term);
+			_ids.emplace(term, id);
+			return id;
+		}
+
+	private:
+		std::unordered_map<std::string_view, TermId> _ids; /**< the ids of the seen terms */
+};
+
 /**
  * A function that is used to parse tags given in a songs file.
  * @param tags the tags and values as a string.
- * @return a map from tag to value.
+ * @param terms the cache to intern the tags with.
+ * @param resource the memory resource of the song.
+ * @return the tags ids and values.
  */
-std::map<std::string, int> parseTagValues(const std::string &tags)
+TagsValue parseTagValues(std::string_view tags, TermsCache &terms,
+						 std::pmr::memory_resource *resource)
 {
-	std::map<std::string, int> tagsValue;
-	std::istringstream iss(removeReduntantBrackets(tags));
+	// The tags are read to a buffer of the thread, so the song gets an array of their exact size.
+	static thread_local std::vector<std::pair<TermId, int> > tagsBuffer;
+	tagsBuffer.clear();
+	std::string_view text = removeReduntantBrackets(tags);
 
-	std::string tag;
-	int value;
-	while (iss >> tag >> value)
+	std::string_view tag;
+	std::string_view value;
+	int tagValue;
+	while (nextWord(text, tag) && nextWord(text, value) && parseValue(value, tagValue))
 	{
-		tagsValue[tag] = value;	
+		tagsBuffer.push_back(std::pair<TermId, int>(terms.intern(tag), tagValue));
 	}
 
-	return tagsValue;
+	return TagsValue(tagsBuffer.begin(), tagsBuffer.end(), resource);
 }
 
 /**
- * A function that is used to parse the insruments given in the songs file.
- * @param instrumentStr a string represents the instruments used in the song.
- * @return a set of used instruments.
+ * A function that is used to parse the words of a field given in the songs file, the instruments
+ * or the lyrics.
+ * @param field a string represents the field, the words are surrounded by curly brackets.
+ * @param terms the cache to intern the words with.
+ * @param resource the memory resource of the song.
+ * @return the ids of the words, in their order.
  */
-std::set<std::string> parseInstruments(const std::string &instrumentsStr)
+SongTerms parseWords(std::string_view field, TermsCache &terms,
+					 std::pmr::memory_resource *resource)
 {
-	std::set<std::string> instruments;
-	std::istringstream iss(removeReduntantBrackets(instrumentsStr));
+	// The words are read to a buffer of the thread, so the song gets an array of their exact size.
+	static thread_local std::vector<TermId> wordsBuffer;
+	wordsBuffer.clear();
+	std::string_view text = removeReduntantBrackets(field);
+	std::string_view word;
 
-	std::string instrument;
-	while (iss >> instrument)
+	while (nextWord(text, word))
 	{
-		instruments.insert(instrument);
+		wordsBuffer.push_back(terms.intern(word));
 	}
 
-	return instruments;
+	return SongTerms(wordsBuffer.begin(), wordsBuffer.end(), resource);
 }
 
 /**
- * A function that is used to parse the lyrics of a song give in the songs file.
- * @param lyricsStr a string representation of the lyrics.
- * @return a vector of the lyrics
+ * A function that is used to parse a single song of the songs file, from its title line to its
+ * last line.
+ * @param reader the reader of the songs file, after the seperator line of the song.
+ * @param terms the cache to intern the terms of the song with.
+ * @param resource the memory resource of a SongArena to create the song and its containers in.
+ * @return the song, or nullptr if the file ended in the middle of the song.
  */
-std::vector<std::string> parseLyrics(const std::string &lyricsStr)
+Song* parseSong(SongsReader &reader, TermsCache &terms, std::pmr::memory_resource *resource)
 {
-	std::vector<std::string> lyrics;
-	std::istringstream iss(removeReduntantBrackets(lyricsStr));
-	std::string word;
+	std::string_view line;
+	if (!reader.nextLine(line))
+	{
+		return nullptr;
+	}
+	// Expect line of title:..
+	std::string_view title = line.substr(TITLE.size() + KEYWORD_VALUE_SEPERATE_LENGTH);
+
+	if (!reader.nextLine(line))
+	{
+		return nullptr;
+	}
+	// Expect a line of "tags: {...}"
+	TagsValue tagsValue = parseTagValues(line, terms, resource);
+
+	if (!reader.nextLine(line))
+	{
+		return nullptr;
+	}
+	// Expect either lyrics or instruments.
+	std::string_view field = line;
+	if (!reader.nextLine(line))
+	{
+		return nullptr;
+	}
 
-	while(iss >> word)
+	// Case vocal song
+	if (field.compare(0, LYRICS.size(), LYRICS) == 0)
 	{
-		lyrics.push_back(word);
+		std::string_view lyricsBy = line.substr(LYRICS_BY.size() + KEYWORD_VALUE_SEPERATE_LENGTH);
+		return (Song*)SongArena::create<Vocal>(resource, title, std::move(tagsValue),
+											   parseWords(field, terms, resource), lyricsBy);
 	}
 
-	return lyrics;
+	// Case Instrumental song, expect a line of "performedBy: "
+	std::string_view performedBy = line.substr(PERFORMED_BY.size() + KEYWORD_VALUE_SEPERATE_LENGTH);
+	int bpm = BPM_UNDEFINED;
+
+	// case the next non empty line is a bpm line
+	if (reader.peekLine(line) && line.compare(0, BPM.size(), BPM) == 0)
+	{
+		reader.nextLine(line);
+		bpm = std::stoi(std::string(line.substr(BPM.size() + KEYWORD_VALUE_SEPERATE_LENGTH)));
+	}
+	return (Song*)SongArena::create<Instrumental>(resource, title, std::move(tagsValue),
+												  parseWords(field, terms, resource), performedBy,
+												  bpm);
+}
+
+/**
+ * A function that is used to parse the songs of a part of the songs file.
+ * @param begin the beginning of the part, the beginning of the file or of a seperator line.
+ * @param end the end of the part, the end of the file or the beginning of a seperator line.
+ * @param songs a vector to fill with the songs of the part.
+ * @param resource the memory resource of a SongArena to create the songs in.
+ * @return true iff the songs ended in the part, by END_OF_SONGS or by a song the file ended in the
+ * middle of, so the songs of the next parts are not a part of the database.
+ */
+bool parseSongsChunk(const char *begin, const char *end, std::vector<Song*> &songs,
+					 std::pmr::memory_resource *resource)
+{
+	SongsReader reader(begin, end);
+	TermsCache terms;
+	std::string_view line;
+
+	// Every song starts with a seperator line.
+	while (reader.nextLine(line))
+	{
+		if (line == END_OF_SONGS)
+		{
+			return true;
+		}
+		Song *song = parseSong(reader, terms, resource);
+		if (song == nullptr)
+		{
+			return true;
+		}
+		songs.push_back(song);
+	}
+	return false;
+}
+
+/**
+ * A function that is used to find the beginning of the first seperator line at a position or after
+ * it, which is the beginning of a song record.
+ * @param position the position to search from, it must be after the beginning of the file.
+ * @param end the end of the file content.
+ * @return the beginning of the seperator line, or end if there is no such line.
+ */
+const char* findSongRecord(const char *position, const char *end)
+{
+	const std::string recordStart = NEW_LINE + SEPERATOR + NEW_LINE;
+	// Start a character before, so a seperator line that starts at the position is found.
+	std::string_view text(position - 1, end - position + 1);
+	size_t pos = text.find(recordStart);
+	return (pos == std::string_view::npos) ? end : text.data() + pos + 1;
 }
 
 /**
  * A function that is used to parse the songs file.
+ * The file is mapped to the memory and tokenized in a single forward pass, only the strings kept
+ * by the songs are copied out of it. In case of several threads the file is split at seperator
+ * lines to chunks of at least MIN_PARSE_CHUNK_SIZE bytes, that are parsed concurrently(every chunk
+ * to its own resource of the arena) and merged in the file order.
  * @param songsFilename the songs file name.
- * @param songs a vector to fill with songs, it is the user responsibility to free the song
- * dynamically assigned memory.
+ * @param songs a vector to fill with songs.
+ * @param arena the arena to create the songs in, the songs are valid as long as it is.
+ * @param numOfThreads the maximal number of threads to parse with.
  * @return true iff the parsing succeeded and the data structures filled correctly.
  */
-bool Parser::parseSongs(const std::string &songsFilename, std::vector<Song*> &songs)
+bool Parser::parseSongs(const std::string &songsFilename, std::vector<Song*> &songs,
+						SongArena &arena, unsigned int numOfThreads)
 {
-	std::ifstream instream(songsFilename.c_str());
-	if (!instream.is_open())
+	MappedFile songsFile;
+	if (!songsFile.open(songsFilename))
 	{
 		std::cerr << "Error! Can't open file: " << songsFilename << "." << std::endl;	
 		return false;
 	}
 
-	std::string line = "";
-	Song *song;
+	size_t numOfChunks = std::max<size_t>(1, std::min<size_t>(numOfThreads,
+											  songsFile.size() / MIN_PARSE_CHUNK_SIZE));
+	if (numOfChunks == 1)
+	{
+		parseSongsChunk(songsFile.begin(), songsFile.end(), songs, arena.newResource());
+		return true;
+	}
+
+	// Split the file near equal parts, every chunk but the first starts at a seperator line.
+	std::vector<const char*> bounds(1, songsFile.begin());
+	for (size_t i = 1; i < numOfChunks; i++)
+	{
+		const char *position = songsFile.begin() + songsFile.size() / numOfChunks * i;
+		bounds.push_back(findSongRecord(std::max(position, bounds.back() + 1), songsFile.end()));
+	}
+	bounds.push_back(songsFile.end());
 
-	while (instream.good())
+	std::vector<std::vector<Song*> > chunksSongs(numOfChunks);
+	std::vector<std::pmr::memory_resource*> resources;
+	for (size_t i = 0; i < numOfChunks; i++)
+	{
+		resources.push_back(arena.newResource());
+	}
+	std::unique_ptr<bool[]> chunksEnded(new bool[numOfChunks]);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < numOfChunks; i++)
 	{
-		if (line.compare(SEPERATOR) != 0)
+		threads.push_back(std::thread([&, i]()
 		{
-			getlineSkipEmpty(instream, line);
-			// Case no more songs
-			if(line.compare(END_OF_SONGS) == 0)
+			chunksEnded[i] = (bounds[i] < bounds[i + 1]) &&
+							 parseSongsChunk(bounds[i], bounds[i + 1], chunksSongs[i], resources[i]);
+		}));
+	}
+	for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		it->join();
+	}
+
+	// Merge in the file order, the songs after the end of the songs are dropped(they are released
+	// with the arena).
+	bool ended = false;
+	for (size_t i = 0; i < numOfChunks && !ended; i++)
+	{
+		songs.insert(songs.end(), chunksSongs[i].begin(), chunksSongs[i].end());
+		ended = chunksEnded[i];
+	}
+	return true;
+}
+
+/**
+ * A function that is used to parse the songs delta log, every change is an ADD_SONG line followed
+ * by a song, or a REMOVE_SONG line followed by the title line of the songs to remove. A change is
+ * complete once the line after it, the next change or an END_OF_CHANGE line, is written.
+ * @param deltaFilename the delta log file name.
+ * @param offset the position in the log to parse from, it is advanced past the complete changes.
+ * @param changes a vector to fill with the changes in the log order.
+ * @param arena the arena to create the added songs in.
+ * @return true iff the log was read and its records are changes.
+ */
+bool Parser::parseSongsDelta(const std::string &deltaFilename, size_t &offset,
+							 std::vector<SongChange> &changes, SongArena &arena)
+{
+	MappedFile deltaFile;
+	if (!deltaFile.open(deltaFilename))
+	{
+		std::cerr << "Error! Can't open file: " << deltaFilename << "." << std::endl;	
+		return false;
+	}
+
+	// Only the lines that were written with their new line are read, the last line may be still
+	// written.
+	const char *begin = deltaFile.begin() + std::min(offset, deltaFile.size());
+	size_t lastNewLine = std::string_view(begin, deltaFile.end() - begin).rfind(NEW_LINE);
+	const char *end = (lastNewLine == std::string_view::npos) ? begin : begin + lastNewLine + 1;
+	SongsReader reader(begin, end);
+	TermsCache terms;
+	std::pmr::memory_resource *resource = arena.newResource();
+	std::string_view line;
+	const char *changeBegin = reader.position();
+	while (reader.nextLine(line))
+	{
+		SongChange change = {nullptr, std::string()};
+		bool isBadChange = false;
+		if (line == ADD_SONG)
+		{
+			change.addedSong = parseSong(reader, terms, resource);
+			if (change.addedSong == nullptr)
 			{
 				break;
 			}
 		}
-		getlineSkipEmpty(instream, line);
-
-		// Expect line of title:..
-		size_t pos = TITLE.size() + KEYWORD_VALUE_SEPERATE_LENGTH;
-		std::string title = line.substr(pos);
-
-		getlineSkipEmpty(instream, line);
-		// Expect a line of "tags: {...}"
-		std::map<std::string, int> tagsValue = parseTagValues(line);
-
-		std::string lyrics = "";
-		std::string lyricsBy = "";
-		std::string instruments = "";
-		std::string performedBy = "";
-		int bpm = BPM_UNDEFINED;
-
-		getlineSkipEmpty(instream, line);
-		// Expect either lyrics or instruments.
-		
-		// Case vocal song
-		if ((line.size() >= LYRICS.size()) && 
-			line.substr(0, LYRICS.size()).compare(LYRICS) == 0)
-		{
-			std::vector<std::string> lyrics = parseLyrics(line);	
-			pos = LYRICS_BY.size() + KEYWORD_VALUE_SEPERATE_LENGTH;
-			getlineSkipEmpty(instream, line);
-			lyricsBy = line.substr(pos);
-			song = (Song*)new Vocal(title, tagsValue, lyrics, lyricsBy);
-		}
-		// Case Instrumental song
-		else
+		else if (line == REMOVE_SONG)
 		{
-			std::set<std::string> instruments = parseInstruments(line);	
-
-			getlineSkipEmpty(instream, line);
-			// Expect a line of "performedBy: "
-			pos = PERFORMED_BY.size() + KEYWORD_VALUE_SEPERATE_LENGTH;
-			performedBy = line.substr(pos);
-
-			// Check if BPM is set
-			if (!instream.good())
+			if (!reader.nextLine(line))
 			{
 				break;
 			}
-
-			std::streampos sp = instream.tellg();
-			getlineSkipEmpty(instream, line);
-
-			// case non empty line is not end of songs and not seperator => its a bpm line!
-			if ((line.compare(END_OF_SONGS) != 0) && (line.compare(SEPERATOR) != 0))
-			{
-				pos = BPM.size() + KEYWORD_VALUE_SEPERATE_LENGTH;
-				bpm = std::stoi(line.substr(pos));
-			}
-			/* if no BPM reverse the getline operation by returning the cursor and set the line to
-			   so it wont contain a seperator and avoid the getline in the if statement at the
-			   beginning of the loop */
-			else
+			// Expect line of title:..
+			isBadChange = line.size() < TITLE.size() + KEYWORD_VALUE_SEPERATE_LENGTH ||
+						  line.compare(0, TITLE.size(), TITLE) != 0;
+			if (!isBadChange)
 			{
-				line = "";
-				instream.seekg(sp);
+				change.removedTitle = line.substr(TITLE.size() + KEYWORD_VALUE_SEPERATE_LENGTH);
 			}
-			song = (Song*)new Instrumental(title, tagsValue, instruments, performedBy, bpm);
 		}
-		
-		songs.push_back(song);
+		else
+		{
+			isBadChange = true;
+		}
+
+		// The change is complete only if the next line is written, it must begin another change.
+		if (!isBadChange && !reader.peekLine(line))
+		{
+			break;
+		}
+		if (isBadChange || (line != ADD_SONG && line != REMOVE_SONG && line != END_OF_CHANGE))
+		{
+			std::cerr << "Error! Bad change in file: " << deltaFilename << "." << std::endl;
+			offset = changeBegin - deltaFile.begin();
+			return false;
+		}
+		if (line == END_OF_CHANGE)
+		{
+			reader.nextLine(line);
+		}
+		changes.push_back(change);
+		changeBegin = reader.position();
 	}
-	instream.close();
+
+	offset = changeBegin - deltaFile.begin();
 	return true;
 }
 
@@ -5,10 +5,14 @@
 #include <vector>
 #include <map>
 #include "Song.h"
+#include "SongArena.h"
 #include "Scorer.h"
 
 const std::string SEPERATOR = "=";
 const std::string END_OF_SONGS = "***";
+const std::string ADD_SONG = "+";
+const std::string REMOVE_SONG = "-";
+const std::string END_OF_CHANGE = ".";
 const std::string TITLE = "title";
 const std::string EMPTY_LINE = "\n";
 const std::string TAGS = "tags";
@@ -25,6 +29,7 @@ const std::string LYRICS_MATCH_SCORE = "lyricsMatchScore";
 const std::string INSTRUMENT_MATCH_SCORE = "instrumentMatchScore";
 const std::string BPM_LIKELIHOOD_WEIGHT = "bpmLikelihoodWeight";
 const int KEYWORD_VALUE_SEPERATE_LENGTH = 2;
+const size_t MIN_PARSE_CHUNK_SIZE = 1 << 20;
 
 /**
  * A namespace represents the API of the Parser module.
@@ -34,11 +39,41 @@ namespace Parser
 	/**
 	 * A function that is used to parse the songs file.
 	 * @param songsFilename the songs file name.
-	 * @param songs a vector to fill with songs, it is the user responsibility to free the song
-	 * dynamically assigned memory.
+	 * @param songs a vector to fill with songs.
+	 * @param arena the arena to create the songs and their containers in, the songs are valid as
+	 * long as it is and are released with it.
+	 * @param numOfThreads the maximal number of threads to parse with, the file is split at
+	 * seperator lines and the songs are kept in the file order.
 	 * @return true iff the parsing succeeded and the data structures filled correctly.
 	 */
-	bool parseSongs(const std::string &songsFileName, std::vector<Song*> &songs);
+	bool parseSongs(const std::string &songsFileName, std::vector<Song*> &songs, SongArena &arena,
+					unsigned int numOfThreads = 1);
+
+	/**
+	 * A struct that represents a single change of the songs delta log.
+	 */
+	struct SongChange
+	{
+		Song *addedSong; /**< the added song, or nullptr in case of a removal */
+		std::string removedTitle; /**< the title of the songs to remove */
+	};
+
+	/**
+	 * A function that is used to parse the songs delta log, a log of changes to the songs file
+	 * that is only appended to. Every change is an ADD_SONG line followed by a song in the
+	 * format of the songs file(without its seperator line), or a REMOVE_SONG line followed by
+	 * the title line of the songs to remove. A change is complete once the line after it, the
+	 * next change or an END_OF_CHANGE line, is written with its new line, since the last line
+	 * of a song(e.g. its optional bpm) may be still unwritten.
+	 * @param deltaFilename the delta log file name.
+	 * @param offset the position in the log to parse from, it is advanced past the complete
+	 * changes, so a change the log ends in the middle of is parsed by the next call.
+	 * @param changes a vector to fill with the changes in the log order.
+	 * @param arena the arena to create the added songs in.
+	 * @return true iff the log was read and its records are changes.
+	 */
+	bool parseSongsDelta(const std::string &deltaFilename, size_t &offset,
+						 std::vector<SongChange> &changes, SongArena &arena);
 
 	/**
 	 * A function that is used to parse the parameters file.
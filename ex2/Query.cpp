@@ -0,0 +1,157 @@
+/*
+ * ----------------------------------------------------------------
+ * This file contains the implementation of the Query class methods
+ * ----------------------------------------------------------------
+ */
+#include <algorithm>
+#include "Query.h"
+
+// The characters that separate the words of a query, both when the line is split to clauses and
+// when the text of a phrase is split to words. These are the spaces of std::isspace, which splits
+// the lyrics to words.
+const std::string QUERY_SEPARATORS = " \t\n\v\f\r";
+
+/**
+ * A function that returns whether a character separates the words of a query.
+ * @param c the character.
+ * @return true iff the character is one of QUERY_SEPARATORS.
+ */
+bool isQuerySpace(char c)
+{
+	return QUERY_SEPARATORS.find(c) != std::string::npos;
+}
+
+/**
+ * A function that splits a text to the words that are separated by spaces.
+ * @param text the text.
+ * @return the words.
+ */
+std::vector<std::string> splitQueryWords(const std::string &text)
+{
+	std::vector<std::string> words;
+	size_t begin = text.find_first_not_of(QUERY_SEPARATORS);
+	while (begin != std::string::npos)
+	{
+		size_t end = text.find_first_of(QUERY_SEPARATORS, begin);
+		words.push_back(text.substr(begin, end - begin));
+		begin = text.find_first_not_of(QUERY_SEPARATORS, end);
+	}
+	return words;
+}
+
+/**
+ * A ctor that parses a query line.
+ * @param line the query line.
+ */
+Query::Query(const std::string &line) :
+	_isSingleWord(line.find(PHRASE_QUOTE) == std::string::npos &&
+				  splitQueryWords(line).size() <= 1)
+{
+	// Split the line to tokens, the text between quotes is a single token.
+	std::vector<Clause> tokens;
+	size_t position = 0;
+	while (position < line.size())
+	{
+		if (isQuerySpace(line[position]))
+		{
+			++position;
+			continue;
+		}
+
+		Clause token;
+		if (line[position] == PHRASE_QUOTE)
+		{
+			// A quote that is not closed ends at the end of the line.
+			size_t end = std::min(line.find(PHRASE_QUOTE, position + 1), line.size());
+			token.words = splitQueryWords(line.substr(position + 1, end - position - 1));
+			token.isPhrase = true;
+			position = end + 1;
+			if (token.words.empty())
+			{
+				continue;
+			}
+		}
+		else
+		{
+			size_t end = position;
+			while (end < line.size() && !isQuerySpace(line[end]) && line[end] != PHRASE_QUOTE)
+			{
+				++end;
+			}
+			token.words.push_back(line.substr(position, end - position));
+			token.isPhrase = false;
+			position = end;
+		}
+		tokens.push_back(token);
+	}
+
+	uint64_t group = 0;
+	bool isAfterClause = false;
+	bool isAnd = false;
+	for (size_t i = 0; i < tokens.size(); i++)
+	{
+		const Clause &token = tokens[i];
+		bool isOperatorWord = !token.isPhrase && (token.words.front() == AND_OPERATOR ||
+												  token.words.front() == OR_OPERATOR);
+		if (isOperatorWord && isAfterClause && (i + 1 < tokens.size()))
+		{
+			isAnd = (token.words.front() == AND_OPERATOR);
+			isAfterClause = false;
+			continue;
+		}
+
+		isAfterClause = true;
+		if (_clauses.size() == MAX_QUERY_CLAUSES)
+		{
+			continue;
+		}
+		if (!isAnd && group != 0)
+		{
+			_groups.push_back(group);
+			group = 0;
+		}
+		group |= static_cast<uint64_t>(1) << _clauses.size();
+		_clauses.push_back(token);
+		isAnd = false;
+	}
+	if (group != 0)
+	{
+		_groups.push_back(group);
+	}
+}
+
+/**
+ * A method that returns whether the query is a single word, a line without quotes and without
+ * spaces between words, which is answered as a whole.
+ * @return true iff the query line is a single word.
+ */
+bool Query::isSingleWord() const
+{
+	return _isSingleWord;
+}
+
+/**
+ * A method that returns the clauses of the query.
+ * @return the clauses, in the order of the line.
+ */
+const std::vector<Query::Clause>& Query::getClauses() const
+{
+	return _clauses;
+}
+
+/**
+ * A method that returns whether a song that matched some of the clauses matches the query.
+ * @param matchedClauses the bit of the position of every matched clause is set.
+ * @return true iff all the clauses of a group were matched.
+ */
+bool Query::isMatch(uint64_t matchedClauses) const
+{
+	for (uint64_t group : _groups)
+	{
+		if ((matchedClauses & group) == group)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,67 @@
+// Query.h
+#ifndef QUERY_H_
+#define QUERY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const std::string AND_OPERATOR = "AND";
+const std::string OR_OPERATOR = "OR";
+const char PHRASE_QUOTE = '"';
+// The clauses a song matched are kept as the bits of a word.
+const unsigned int MAX_QUERY_CLAUSES = 64;
+
+/**
+ * A class that represents a query line of several clauses, a clause is a word or a phrase of the
+ * lyrics(words in double quotes). The clauses are separated by AND or OR, a space alone is OR, and
+ * AND binds before OR, so the query is an OR of groups of clauses that all must match.
+ * AND and OR are operators only between two clauses, and the clauses after MAX_QUERY_CLAUSES are
+ * ignored.
+ */
+class Query
+{
+	public:
+		/**
+		 * A struct that represents a clause of the query.
+		 */
+		struct Clause
+		{
+			std::vector<std::string> words; /**< the word, or the words of the phrase */
+			bool isPhrase; /**< true iff the words are a phrase of the lyrics */
+		};
+
+		/**
+		 * A ctor that parses a query line.
+		 * @param line the query line.
+		 */
+		explicit Query(const std::string &line);
+
+		/**
+		 * A method that returns whether the query is a single word, a line without quotes and
+		 * without spaces between words. Such a line is answered as before the clauses, as a
+		 * whole, so the spaces around the word(e.g. the '\r' of a CRLF line) are a part of it.
+		 * @return true iff the query line is a single word.
+		 */
+		bool isSingleWord() const;
+
+		/**
+		 * A method that returns the clauses of the query.
+		 * @return the clauses, in the order of the line.
+		 */
+		const std::vector<Clause>& getClauses() const;
+
+		/**
+		 * A method that returns whether a song that matched some of the clauses matches the query.
+		 * @param matchedClauses the bit of the position of every matched clause is set.
+		 * @return true iff all the clauses of a group were matched.
+		 */
+		bool isMatch(uint64_t matchedClauses) const;
+
+	private:
+		bool _isSingleWord; /**< true iff the line has no quotes and at most one word */
+		std::vector<Clause> _clauses; /**< the clauses */
+		std::vector<uint64_t> _groups; /**< the clauses of every AND group, as bits */
+};
+
+#endif // QUERY_H_
@@ -0,0 +1,230 @@
+/*
+ * ----------------------------------------------------------------------
+ * This file contains the implementation of the QueryServer class methods
+ * ----------------------------------------------------------------------
+ */
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "QueryServer.h"
+
+const size_t READ_BUFFER_SIZE = 1 << 16;
+const char QUERY_SEPERATOR = '\n';
+
+/**
+ * A function that is used to write a whole buffer to a file descriptor.
+ * @param fd the file descriptor.
+ * @param data the buffer.
+ * @return true iff all the buffer was written.
+ */
+bool writeAll(int fd, const std::string &data)
+{
+	size_t written = 0;
+	while (written < data.size())
+	{
+		ssize_t result = write(fd, data.data() + written, data.size() - written);
+		if (result < 0 && errno != EINTR)
+		{
+			return false;
+		}
+		written += (result > 0) ? result : 0;
+	}
+	return true;
+}
+
+/**
+ * The default ctor, starts the worker threads.
+ * @param answerer the function that answers a query, it is called by several threads
+ * at once.
+ * @param numOfWorkers the number of worker threads.
+ * @param capacity the maximal number of queries that wait to be answered, per client
+ * too.
+ */
+QueryServer::QueryServer(const Answerer &answerer, unsigned int numOfWorkers, size_t capacity) :
+						 _answerer(answerer), _capacity(capacity), _requests(capacity),
+						 _numOfClients(0)
+{
+	for (unsigned int i = 0; i < numOfWorkers; i++)
+	{
+		_workers.push_back(std::thread(&QueryServer::_work, this));
+	}
+}
+
+/**
+ * The destructor, stops the worker threads after the socket clients left and the waiting
+ * queries are answered.
+ */
+QueryServer::~QueryServer()
+{
+	{
+		std::unique_lock<std::mutex> lock(_clientsMutex);
+		_noClients.wait(lock, [this]() { return _numOfClients == 0; });
+	}
+	_requests.close();
+	for (std::vector<std::thread>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		it->join();
+	}
+}
+
+/**
+ * A method that serves a single client, until its input ends and all its queries are
+ * answered.
+ * The client is read by the calling thread and written by another thread, so a client may wait
+ * for an answer before it sends the next query.
+ * @param inputFd the file descriptor the queries are read from.
+ * @param outputFd the file descriptor the answers are written to.
+ */
+void QueryServer::serveStream(int inputFd, int outputFd)
+{
+	BoundedQueue<std::future<std::string> > answers(_capacity);
+	std::thread writer([&]()
+	{
+		bool isConnected = true;
+		std::future<std::string> answer;
+		while (answers.pop(answer))
+		{
+			std::string text;
+			try
+			{
+				text = answer.get();
+			}
+			catch (std::exception &ex)
+			{
+				text = std::string("Error! ") + ex.what() + QUERY_SEPERATOR;
+			}
+			// The answers of a client that left are still waited for, but not written.
+			isConnected = isConnected && writeAll(outputFd, text + END_OF_ANSWER + QUERY_SEPERATOR);
+		}
+	});
+
+	auto submit = [&](const std::string &query)
+	{
+		// Empty lines are skipped like in the queries file.
+		if (query.empty())
+		{
+			return;
+		}
+		Request request;
+		request.query = query;
+		answers.push(request.answer.get_future());
+		_requests.push(std::move(request));
+	};
+
+	std::vector<char> buffer(READ_BUFFER_SIZE);
+	std::string pending;
+	ssize_t result;
+	while ((result = read(inputFd, buffer.data(), buffer.size())) != 0)
+	{
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+		pending.append(buffer.data(), result);
+		size_t begin = 0;
+		size_t end;
+		while ((end = pending.find(QUERY_SEPERATOR, begin)) != std::string::npos)
+		{
+			submit(pending.substr(begin, end - begin));
+			begin = end + 1;
+		}
+		pending.erase(0, begin);
+	}
+	submit(pending);
+
+	answers.close();
+	writer.join();
+}
+
+/**
+ * A method that serves the clients of a unix domain socket, every client by its own
+ * thread. It returns only in case of an error.
+ * @param socketPath the path of the socket, a file of this path is replaced.
+ * @return false, after the error is written.
+ */
+bool QueryServer::serveSocket(const std::string &socketPath)
+{
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		std::cerr << "Error! The socket path is too long: " << socketPath << "." << std::endl;
+		return false;
+	}
+	socketPath.copy(address.sun_path, socketPath.size());
+
+	// A client that leaves before its answers are written should not kill the server.
+	signal(SIGPIPE, SIG_IGN);
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(socketPath.c_str());
+	if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+		|| listen(listener, SOMAXCONN) != 0)
+	{
+		std::cerr << "Error! Can't listen on socket: " << socketPath << " (" << strerror(errno)
+				  << ")." << std::endl;
+		if (listener >= 0)
+		{
+			close(listener);
+		}
+		return false;
+	}
+
+	while (true)
+	{
+		int client = accept(listener, nullptr, nullptr);
+		if (client < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+			{
+				continue;
+			}
+			std::cerr << "Error! Can't accept a client: " << strerror(errno) << "." << std::endl;
+			close(listener);
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_clientsMutex);
+			_numOfClients++;
+		}
+		std::thread([this, client]()
+		{
+			serveStream(client, client);
+			close(client);
+			std::lock_guard<std::mutex> lock(_clientsMutex);
+			if (--_numOfClients == 0)
+			{
+				_noClients.notify_all();
+			}
+		}).detach();
+	}
+}
+
+/**
+ * A method that is run by every worker thread, it answers queries until the queue is
+ * closed.
+ */
+void QueryServer::_work()
+{
+	Request request;
+	while (_requests.pop(request))
+	{
+		try
+		{
+			request.answer.set_value(_answerer(request.query));
+		}
+		catch (...)
+		{
+			request.answer.set_exception(std::current_exception());
+		}
+	}
+}
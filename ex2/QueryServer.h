@@ -0,0 +1,90 @@
+// QueryServer.h
+#ifndef QUERY_SERVER_H_
+#define QUERY_SERVER_H_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BoundedQueue.h"
+
+const std::string END_OF_ANSWER = ".";
+
+/**
+ * A class that represents a server that answers queries by a line protocol: every line of a
+ * client is a query, and the answer of every query is written back followed by an END_OF_ANSWER
+ * line, in the order of the queries. The queries of all the clients are answered by a fixed
+ * number of worker threads through a bounded queue.
+ */
+class QueryServer
+{
+	public:
+		/**
+		 * A function that answers a query.
+		 */
+		typedef std::function<std::string(const std::string&)> Answerer;
+
+		/**
+		 * The default ctor, starts the worker threads.
+		 * @param answerer the function that answers a query, it is called by several threads
+		 * at once.
+		 * @param numOfWorkers the number of worker threads.
+		 * @param capacity the maximal number of queries that wait to be answered, per client
+		 * too.
+		 */
+		QueryServer(const Answerer &answerer, unsigned int numOfWorkers, size_t capacity);
+
+		/**
+		 * The destructor, stops the worker threads after the socket clients left and the waiting
+		 * queries are answered.
+		 */
+		~QueryServer();
+
+		QueryServer(const QueryServer&) = delete;
+		QueryServer& operator=(const QueryServer&) = delete;
+
+		/**
+		 * A method that serves a single client, until its input ends and all its queries are
+		 * answered.
+		 * @param inputFd the file descriptor the queries are read from.
+		 * @param outputFd the file descriptor the answers are written to.
+		 */
+		void serveStream(int inputFd, int outputFd);
+
+		/**
+		 * A method that serves the clients of a unix domain socket, every client by its own
+		 * thread. It returns only in case of an error.
+		 * @param socketPath the path of the socket, a file of this path is replaced.
+		 * @return false, after the error is written.
+		 */
+		bool serveSocket(const std::string &socketPath);
+
+	private:
+		/**
+		 * A struct that represents a query waiting to be answered.
+		 */
+		struct Request
+		{
+			std::string query; /**< the query */
+			std::promise<std::string> answer; /**< the answer of the query */
+		};
+
+		/**
+		 * A method that is run by every worker thread, it answers queries until the queue is
+		 * closed.
+		 */
+		void _work();
+
+		Answerer _answerer; /**< the function that answers a query */
+		size_t _capacity; /**< the maximal number of waiting queries */
+		BoundedQueue<Request> _requests; /**< the queries waiting to be answered */
+		std::vector<std::thread> _workers; /**< the worker threads */
+		unsigned int _numOfClients; /**< the number of the socket clients being served */
+		std::mutex _clientsMutex; /**< a mutex that guards the number of clients */
+		std::condition_variable _noClients; /**< signaled when the last client leaves */
+};
+
+#endif // QUERY_SERVER_H_
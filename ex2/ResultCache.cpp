@@ -0,0 +1,301 @@
+/*
+ * ----------------------------------------------------------------------
+ * This file contains the implementation of the ResultCache class methods
+ * ----------------------------------------------------------------------
+ */
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include "Hash.h"
+#include "ResultCache.h"
+
+const char CACHE_FILE_MAGIC[4] = {'M', 'I', 'R', 'C'};
+const uint32_t CACHE_FILE_VERSION = 2;
+const std::string TEMPORARY_FILE_SUFFIX = ".tmp.";
+// The memory of the list node, the map node and the vector of every result.
+const size_t ENTRY_OVERHEAD = 128;
+
+/**
+ * A function that is used to write a value to a binary file.
+ * @param output the file.
+ * @param value the value.
+ */
+template<typename T>
+void writeValue(std::ostream &output, const T &value)
+{
+	output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * A function that is used to read a value from a binary file.
+ * @param input the file.
+ * @param value the value to read to.
+ * @return true iff the value was read.
+ */
+template<typename T>
+bool readValue(std::istream &input, T &value)
+{
+	return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+ * The default ctor used to create an empty cache.
+ * @param budget the maximal number of bytes of the cached results.
+ * @param parametersHash the hash of the scoring parameters.
+ * @param catalogVersion the version of the catalog.
+ * @param numOfSongs the number of songs of the catalog, the loaded results are checked by it.
+ */
+ResultCache::ResultCache(size_t budget, uint64_t parametersHash, uint64_t catalogVersion,
+						 unsigned int numOfSongs) :
+						 _budget(budget), _usedBytes(0), _parametersHash(parametersHash),
+						 _catalogVersion(catalogVersion), _numOfSongs(numOfSongs)
+{
+}
+
+/**
+ * A method that looks the result of a query up, the result becomes the most recently used.
+ * @param query the query.
+ * @param top the number of results of the query, or 0 for all of them.
+ * @param result the result to copy to.
+ * @return true iff the result was cached.
+ */
+bool ResultCache::find(const std::string &query, unsigned int top, Result &result)
+{
+	std::string key = _key(query, top);
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::unordered_map<std::string_view, std::list<Entry>::iterator>::const_iterator it =
+		_keys.find(key);
+	if (it == _keys.end())
+	{
+		return false;
+	}
+	_entries.splice(_entries.begin(), _entries, it->second);
+	result = it->second->result;
+	return true;
+}
+
+/**
+ * A method that caches the result of a query as the most recently used.
+ * @param query the query.
+ * @param top the number of results of the query, or 0 for all of them.
+ * @param result the result.
+ */
+void ResultCache::insert(const std::string &query, unsigned int top, const Result &result)
+{
+	Entry entry = {_key(query, top), result};
+	std::lock_guard<std::mutex> lock(_mutex);
+	_insert(std::move(entry));
+}
+
+/**
+ * A method that drops all the cached results, since the catalog has changed.
+ * @param catalogVersion the new version of the catalog.
+ * @param numOfSongs the new number of songs of the catalog.
+ */
+void ResultCache::invalidate(uint64_t catalogVersion, unsigned int numOfSongs)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_keys.clear();
+	_entries.clear();
+	_usedBytes = 0;
+	_catalogVersion = catalogVersion;
+	_numOfSongs = numOfSongs;
+}
+
+/**
+ * A method that loads the results saved to a file, in case the file was saved with the same
+ * parameters and catalog, its checksum matches and all its songs are in the catalog. Nothing is
+ * loaded from a bad file.
+ * @param fileName the name of the file.
+ * @return true iff the results were loaded.
+ */
+bool ResultCache::load(const std::string &fileName)
+{
+	std::ifstream input(fileName.c_str(), std::ios::binary);
+	char magic[sizeof(CACHE_FILE_MAGIC)];
+	uint32_t version;
+	uint64_t parametersHash;
+	uint64_t catalogVersion;
+	uint64_t imageSize;
+	uint64_t checksum;
+	if (!input.read(magic, sizeof(magic)) || !readValue(input, version) ||
+		!readValue(input, parametersHash) || !readValue(input, catalogVersion) ||
+		!readValue(input, imageSize) || !readValue(input, checksum) ||
+		!std::equal(magic, magic + sizeof(magic), CACHE_FILE_MAGIC) ||
+		version != CACHE_FILE_VERSION || parametersHash != _parametersHash ||
+		catalogVersion != _catalogVersion)
+	{
+		return false;
+	}
+
+	// The image is the rest of the file.
+	std::streampos imageBegin = input.tellg();
+	input.seekg(0, std::ios::end);
+	if (static_cast<uint64_t>(input.tellg() - imageBegin) != imageSize)
+	{
+		return false;
+	}
+	input.seekg(imageBegin);
+	std::string image(imageSize, '\0');
+	if (!input.read(&image[0], imageSize) || hashWords(image.data(), image.size()) != checksum)
+	{
+		return false;
+	}
+
+	// The entries are read first, so a bad entry leaves the cache as it was.
+	std::istringstream entries(image);
+	uint64_t numOfEntries;
+	if (!readValue(entries, numOfEntries) || numOfEntries > imageSize)
+	{
+		return false;
+	}
+	std::vector<Entry> loaded;
+	for (uint64_t i = 0; i < numOfEntries; i++)
+	{
+		uint32_t keySize;
+		uint64_t resultSize;
+		Entry entry;
+		if (!readValue(entries, keySize) || keySize > imageSize)
+		{
+			return false;
+		}
+		entry.key.resize(keySize);
+		if (!entries.read(&entry.key[0], keySize) || !readValue(entries, resultSize) ||
+			resultSize > imageSize / sizeof(ScoredSong))
+		{
+			return false;
+		}
+		entry.result.resize(resultSize);
+		if (!entries.read(reinterpret_cast<char*>(entry.result.data()),
+						  resultSize * sizeof(ScoredSong)))
+		{
+			return false;
+		}
+		for (const ScoredSong &scoredSong : entry.result)
+		{
+			if (scoredSong.song >= _numOfSongs)
+			{
+				return false;
+			}
+		}
+		loaded.push_back(std::move(entry));
+	}
+
+	// The results are saved from the least recently used, so the last one inserted is the most.
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (std::vector<Entry>::iterator it = loaded.begin(); it != loaded.end(); ++it)
+	{
+		_insert(std::move(*it));
+	}
+	return true;
+}
+
+/**
+ * A method that saves the results to a file, the file is written under a temporary name(of the
+ * process, so several processes do not write the same file) and then renamed over the file, so
+ * it is never left half written.
+ * @param fileName the name of the file.
+ * @return true iff the results were saved.
+ */
+bool ResultCache::save(const std::string &fileName) const
+{
+	std::ostringstream entries;
+	uint64_t parametersHash;
+	uint64_t catalogVersion;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		parametersHash = _parametersHash;
+		catalogVersion = _catalogVersion;
+		writeValue(entries, static_cast<uint64_t>(_entries.size()));
+		for (std::list<Entry>::const_reverse_iterator it = _entries.rbegin();
+			 it != _entries.rend(); ++it)
+		{
+			writeValue(entries, static_cast<uint32_t>(it->key.size()));
+			entries.write(it->key.data(), it->key.size());
+			writeValue(entries, static_cast<uint64_t>(it->result.size()));
+			entries.write(reinterpret_cast<const char*>(it->result.data()),
+						  it->result.size() * sizeof(ScoredSong));
+		}
+	}
+	std::string image = entries.str();
+
+	std::string temporaryName = fileName + TEMPORARY_FILE_SUFFIX + std::to_string(getpid());
+	std::ofstream output(temporaryName.c_str(), std::ios::binary | std::ios::trunc);
+	if (!output.is_open())
+	{
+		return false;
+	}
+	output.write(CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+	writeValue(output, CACHE_FILE_VERSION);
+	writeValue(output, parametersHash);
+	writeValue(output, catalogVersion);
+	writeValue(output, static_cast<uint64_t>(image.size()));
+	writeValue(output, hashWords(image.data(), image.size()));
+	output.write(image.data(), image.size());
+	output.close();
+	if (!output || std::rename(temporaryName.c_str(), fileName.c_str()) != 0)
+	{
+		std::remove(temporaryName.c_str());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * A method that returns the key of a query.
+ * @param query the query.
+ * @param top the number of results of the query.
+ * @return the key.
+ */
+std::string ResultCache::_key(const std::string &query, unsigned int top)
+{
+	// A query is a single line, so it never contains the new line that separates the number.
+	return query + '\n' + std::to_string(top);
+}
+
+/**
+ * A method that returns the memory used by a cached result.
+ * @param entry the cached result.
+ * @return the number of bytes.
+ */
+size_t ResultCache::_entrySize(const Entry &entry)
+{
+	return ENTRY_OVERHEAD + entry.key.size() + entry.result.size() * sizeof(ScoredSong);
+}
+
+/**
+ * A method that caches a result as the most recently used and drops the least recently
+ * used results while the cache exceeds its budget, the mutex should be locked.
+ * @param entry the result to cache.
+ */
+void ResultCache::_insert(Entry &&entry)
+{
+	size_t size = _entrySize(entry);
+	if (size > _budget)
+	{
+		return;
+	}
+
+	std::unordered_map<std::string_view, std::list<Entry>::iterator>::iterator it =
+		_keys.find(entry.key);
+	if (it != _keys.end())
+	{
+		// The key of the map is a view of the key of the entry, so it is erased first.
+		std::list<Entry>::iterator old = it->second;
+		_keys.erase(it);
+		_usedBytes -= _entrySize(*old);
+		_entries.erase(old);
+	}
+
+	_entries.push_front(std::move(entry));
+	_keys.emplace(_entries.front().key, _entries.begin());
+	_usedBytes += size;
+	while (_usedBytes > _budget)
+	{
+		_usedBytes -= _entrySize(_entries.back());
+		_keys.erase(_entries.back().key);
+		_entries.pop_back();
+	}
+}
@@ -0,0 +1,133 @@
+// ResultCache.h
+#ifndef RESULT_CACHE_H_
+#define RESULT_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A struct that represents a scored song, used to rank the results.
+ */
+struct ScoredSong
+{
+	unsigned int song; /**< the position of the song */
+	int score; /**< the score of the song */
+};
+
+/**
+ * A class that represents a cache of the ranked results of queries, the least recently used
+ * results are dropped when the cache exceeds its memory budget.
+ * The results are valid for a single scoring parameters and catalog, given by their hashes, a
+ * cache file of other parameters or another catalog is ignored, and so is a corrupted file.
+ * The cache may be used by several threads at once.
+ */
+class ResultCache
+{
+	public:
+		/**
+		 * The ranked songs of a query.
+		 */
+		typedef std::vector<ScoredSong> Result;
+
+		/**
+		 * The default ctor used to create an empty cache.
+		 * @param budget the maximal number of bytes of the cached results.
+		 * @param parametersHash the hash of the scoring parameters.
+		 * @param catalogVersion the version of the catalog.
+		 * @param numOfSongs the number of songs of the catalog, the loaded results are checked
+		 * by it.
+		 */
+		ResultCache(size_t budget, uint64_t parametersHash, uint64_t catalogVersion,
+					unsigned int numOfSongs);
+
+		/**
+		 * A method that looks the result of a query up, the result becomes the most recently used.
+		 * @param query the query.
+		 * @param top the number of results of the query, or 0 for all of them.
+		 * @param result the result to copy to.
+		 * @return true iff the result was cached.
+		 */
+		bool find(const std::string &query, unsigned int top, Result &result);
+
+		/**
+		 * A method that caches the result of a query as the most recently used.
+		 * @param query the query.
+		 * @param top the number of results of the query, or 0 for all of them.
+		 * @param result the result.
+		 */
+		void insert(const std::string &query, unsigned int top, const Result &result);
+
+		/**
+		 * A method that drops all the cached results, since the catalog has changed.
+		 * @param catalogVersion the new version of the catalog.
+		 * @param numOfSongs the new number of songs of the catalog.
+		 */
+		void invalidate(uint64_t catalogVersion, unsigned int numOfSongs);
+
+		/**
+		 * A method that loads the results saved to a file, in case the file was saved with the
+		 * same parameters and catalog, its checksum matches and all its songs are in the catalog.
+		 * Nothing is loaded from a bad file.
+		 * @param fileName the name of the file.
+		 * @return true iff the results were loaded.
+		 */
+		bool load(const std::string &fileName);
+
+		/**
+		 * A method that saves the results to a file, the file is written under a temporary name
+		 * and then renamed, so it is never left half written.
+		 * @param fileName the name of the file.
+		 * @return true iff the results were saved.
+		 */
+		bool save(const std::string &fileName) const;
+
+	private:
+		/**
+		 * A struct that represents a cached result.
+		 */
+		struct Entry
+		{
+			std::string key; /**< the query and the number of results */
+			Result result; /**< the ranked songs */
+		};
+
+		/**
+		 * A method that returns the key of a query.
+		 * @param query the query.
+		 * @param top the number of results of the query.
+		 * @return the key.
+		 */
+		static std::string _key(const std::string &query, unsigned int top);
+
+		/**
+		 * A method that returns the memory used by a cached result.
+		 * @param entry the cached result.
+		 * @return the number of bytes.
+		 */
+		static size_t _entrySize(const Entry &entry);
+
+		/**
+		 * A method that caches a result as the most recently used and drops the least recently
+		 * used results while the cache exceeds its budget, the mutex should be locked.
+		 * @param entry the result to cache.
+		 */
+		void _insert(Entry &&entry);
+
+		size_t _budget; /**< the maximal number of bytes of the cached results */
+		size_t _usedBytes; /**< the number of bytes of the cached results */
+		uint64_t _parametersHash; /**< the hash of the scoring parameters */
+		uint64_t _catalogVersion; /**< the version of the catalog */
+		unsigned int _numOfSongs; /**< the number of songs of the catalog */
+		std::list<Entry> _entries; /**< the results, the most recently used first */
+		std::unordered_map<std::string_view, std::list<Entry>::iterator> _keys; /**< a map from
+																				  every key to
+																				  its result */
+		mutable std::mutex _mutex; /**< a mutex that guards the cache */
+};
+
+#endif // RESULT_CACHE_H_
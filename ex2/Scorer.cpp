@@ -1,4 +1,5 @@
 #include "Scorer.h"
+#include "Hash.h"
 #include <iostream>
 #include <algorithm>
 
@@ -8,16 +9,102 @@
  * -----------------------------------------------------------------
  */
 
+/**
+ * A function that is used to calculate the following likelihood formula
+ * using the likelihood formula floor(BPM_SCORE_WEIGHT * (e^(-((bpm-m)^2 / 2*s^2)) ))
+ * @param bpmScoreWeight the score weight for bpm.
+ * @param songBpm the beats per minute of the song.
+ * @param avarage the pre calculated average for a known word.
+ * @param standardDeviation the standard deviation pre pre calculated for a known word.
+ */
+inline int _likeliHood(int bpmScoreWeight, int songBpm, double average, 
+					   double standardDeviation)
+{
+	return floor(bpmScoreWeight * exp(-(pow((songBpm - average), BPM_SCORE_POWER_CONST) /
+										(BPM_SCORE_DIVISOR_CONST * pow(standardDeviation, 
+										BPM_SCORE_POWER_CONST)))));
+}
+
 /**
  * The default ctor used to create a Scorer.
  * @param scoreWeight the weight of each parameter in the end score.
  * @param knownKeywords key words that was previously learned and check to get better
  * results.
+ * @throws std::out_of_range in case the weight of a parameter is missing.
  */
 Scorer::Scorer(const std::map<Scorer::ScoreParameters, int> &scoreWeight,
 			   const std::map<std::string, std::pair<double, double> > &knownKeywords) :
-			   _scoreWeight(scoreWeight), _knownWords(knownKeywords)
+			   _knownWords(knownKeywords), _bpmScoresMin(BPM_UNDEFINED),
+			   _bpmScores(_knownWords.size())
+{
+	for (int parameter = TAGS; parameter < NUM_OF_SCORE_PARAMETERS; parameter++)
+	{
+		_scoreWeight[parameter] = scoreWeight.at(static_cast<ScoreParameters>(parameter));
+	}
+
+	_parametersHash = hashBytes(_scoreWeight.data(), sizeof(_scoreWeight));
+	for (std::map<std::string, std::pair<double, double> >::const_iterator it =
+		 knownKeywords.begin(); it != knownKeywords.end(); ++it)
+	{
+		// The size separates the word from the next bytes.
+		uint64_t wordSize = it->first.size();
+		_parametersHash = hashBytes(&wordSize, sizeof(wordSize), _parametersHash);
+		_parametersHash = hashBytes(it->first.data(), it->first.size(), _parametersHash);
+		_parametersHash = hashBytes(&it->second.first, sizeof(double), _parametersHash);
+		_parametersHash = hashBytes(&it->second.second, sizeof(double), _parametersHash);
+	}
+}
+
+/**
+ * A method that calculates the bpm score of every bpm of a range once for every known word, so
+ * the songs are scored by a table lookup. The tables are not built for a range larger than
+ * MAX_BPM_SCORES_TABLE_SIZE or than the number of songs that have a bpm, since scoring those
+ * songs by the formula is cheaper then.
+ * @param minBpm the minimal bpm of the songs to score.
+ * @param maxBpm the maximal bpm of the songs to score.
+ * @param numOfBpmSongs the number of songs that have a bpm.
+ */
+void Scorer::prepareBpmScores(int minBpm, int maxBpm, size_t numOfBpmSongs)
+{
+	long long tableSize = static_cast<long long>(maxBpm) - minBpm + 1;
+	bool isTabled = (minBpm != BPM_UNDEFINED) && (tableSize > 0) &&
+					(tableSize <= MAX_BPM_SCORES_TABLE_SIZE) &&
+					(static_cast<unsigned long long>(tableSize) <= numOfBpmSongs);
+	_bpmScoresMin = minBpm;
+	for (size_t word = 0; word < _knownWords.size(); word++)
+	{
+		std::vector<int> &bpmScores = _bpmScores[word];
+		bpmScores.clear();
+		if (!isTabled)
+		{
+			continue;
+		}
+		const KnownWordsTable::KnownWord &knownWord = _knownWords.at(word);
+		bpmScores.reserve(tableSize);
+		for (long long bpm = minBpm; bpm <= maxBpm; bpm++)
+		{
+			bpmScores.push_back(_likeliHood(_scoreWeight[BPM], static_cast<int>(bpm),
+											knownWord.average, knownWord.standardDeviation));
+		}
+	}
+}
+
+/**
+ * A method that resolves a query, the result is valid as long as the scorer exists and
+ * prepareBpmScores is not called again.
+ * @param query the query.
+ * @return the prepared query.
+ */
+Scorer::PreparedQuery Scorer::prepareQuery(const std::string &query) const
 {
+	static const std::vector<int> noBpmScores;
+	PreparedQuery prepared = {TermDictionary::getInstance().find(query), _knownWords.find(query),
+							  &noBpmScores};
+	if (prepared.knownWord != nullptr)
+	{
+		prepared.bpmScores = &_bpmScores[prepared.knownWord->position];
+	}
+	return prepared;
 }
 
 /**
@@ -29,76 +116,122 @@ Scorer::Scorer(const std::map<Scorer::ScoreParameters, int> &scoreWeight,
  */
 int Scorer::getScore(const Song &song, const std::string &query) const
 {
-	return _tagsMatchScore(song, query) + _wordOccurenceScore(song, query) + 
-		   _instrumentUsedScore(song, query) + _bpmScore(song, query);
+	PreparedQuery prepared = prepareQuery(query);
+	return _tagsMatchScore(song, prepared.term) + _wordOccurenceScore(song, prepared.term) + 
+		   _instrumentUsedScore(song, prepared.term) + _bpmScore(song.getBpm(), prepared);
+}
+
+/**
+ * A method that returns the score of a song by its posting of the query.
+ * @param posting the posting of the query in the song.
+ * @param bpm the bpm of the song.
+ * @param query the prepared query to score.
+ * @return the total matching score of the song with the given query.
+ */
+int Scorer::getScore(const SongIndex::Posting &posting, int bpm, const PreparedQuery &query) const
+{
+	return (posting.tagValue * _scoreWeight[TAGS]) + 
+		   (posting.lyricsCount * _scoreWeight[LYRICS]) +
+		   (posting.instrumentUsed ? _scoreWeight[INSTRUMENTS] : NO_INSTRUMENT_SCORE) + 
+		   _bpmScore(bpm, query);
+}
+
+/**
+ * A method that returns true iff a word is a known word, so it is scored by the bpm of
+ * every song that has one.
+ * @param word the word to check.
+ * @return true iff the word is known.
+ */
+bool Scorer::isKnownWord(const std::string &word) const
+{
+	return (_knownWords.find(word) != nullptr);
+}
+
+/**
+ * A method that returns the score of a phrase of the lyrics, every occurence of the phrase
+ * scores as an occurence of a word.
+ * @param occurences the number of times the phrase occures in the lyrics of the song.
+ * @return the score of the phrase.
+ */
+int Scorer::getPhraseScore(int occurences) const
+{
+	return occurences * _scoreWeight[LYRICS];
+}
+
+/**
+ * A method that returns an upper bound of the bpm score of any song and query, the likelihood is
+ * at most 1 so the score is at most the bpm weight.
+ * @return the maximal bpm score.
+ */
+int Scorer::getMaxBpmScore() const
+{
+	return std::max(_scoreWeight[BPM], 0);
+}
+
+/**
+ * A method that returns a hash of the scoring parameters, the weights and the known
+ * words, so results of other parameters can be told apart.
+ * @return the hash.
+ */
+uint64_t Scorer::getParametersHash() const
+{
+	return _parametersHash;
 }
 
 /**
 * A methd that calculates the score gained from matched tags.
 * @param song a song to score.
-* @param tag a tag to score.
+* @param tag the id of a tag to score.
 * @return the score gained if the tag match.
 */
-int Scorer::_tagsMatchScore(const Song &song, const std::string &tag) const
+int Scorer::_tagsMatchScore(const Song &song, TermId tag) const
 {
-	return song.tagValue(tag) * _scoreWeight.at(TAGS);
+	return song.tagValue(tag) * _scoreWeight[TAGS];
 }
 
 /**
 * A method that calculates the score gained by a word occurence int the lyrics.
 * @param song a song to score.
-* @param word a word to score.
+* @param word the id of a word to score.
 * @return the score gained by the number of occurence of the word in the lyrics.
 */
-int Scorer::_wordOccurenceScore(const Song &song, const std::string &word) const
+int Scorer::_wordOccurenceScore(const Song &song, TermId word) const
 {
-	std::vector<std::string> lyrics = song.getLyrics();
-	int occurence = std::count (lyrics.begin(), lyrics.end(), word);
-	return occurence * _scoreWeight.at(LYRICS);
+	return song.wordOccurence(word) * _scoreWeight[LYRICS];
 }
 
 /**
 * A method that calculates the score gained if a given instrument is used.
 * @param song a song to score.
-* @param instrument an instrument to score.
+* @param instrument the id of an instrument to score.
 * @return the score gained if the instrument is used.
 */
-int Scorer::_instrumentUsedScore(const Song &song, const std::string &instrument) const
+int Scorer::_instrumentUsedScore(const Song &song, TermId instrument) const
 {
-	return (song.isInstrumentUsed(instrument) ? _scoreWeight.at(INSTRUMENTS) : NO_INSTRUMENT_SCORE);
+	const SongTerms &instruments = song.getInstrumentsTerms();
+	return (std::binary_search(instruments.begin(), instruments.end(), instrument) ? 
+			_scoreWeight[INSTRUMENTS] : NO_INSTRUMENT_SCORE);
 }
 
-	
-/**
- * A function that is used to calculate the following likelihood formula
- * using the likelihood formula floor(BPM_SCORE_WEIGHT * (e^(-((bpm-m)^2 / 2*s^2)) ))
- * @param bpmScoreWeight the score weight for bpm.
- * @param songBpm the beats per minute of the song.
- * @param avarage the pre calculated average for a known word.
- * @param standardDeviation the standard deviation pre pre calculated for a known word.
- */
-inline int _likeliHood(int bpmScoreWeight, int songBpm, double average, 
-					   double standardDeviation)
-{
-	return floor(bpmScoreWeight * exp(-(pow((songBpm - average), BPM_SCORE_POWER_CONST) /
-										(BPM_SCORE_DIVISOR_CONST * pow(standardDeviation, 
-										BPM_SCORE_POWER_CONST)))));
-}
 
 /**
 * A method that calculates the score gained by bpm compatibility with a knownWord.
-* @param song a song to score.
-* @param knownWord a word to check
+* @param bpm the bpm of the song to score.
+* @param query the prepared query to check.
 * @return the score gained by bpm compatability with the knownWord.
 */
-int Scorer::_bpmScore(const Song &song, const std::string &knownWord) const
+int Scorer::_bpmScore(int bpm, const PreparedQuery &query) const
 {
-	if ((_knownWords.find(knownWord) == _knownWords.end()) || (song.getBpm() == BPM_UNDEFINED))
+	if ((query.knownWord == nullptr) || (bpm == BPM_UNDEFINED))
 	{
 		return 0;
 	}
-	double average = _knownWords.at(knownWord).first;
-	double standardDeviation = _knownWords.at(knownWord).second;
-
-	return _likeliHood(_scoreWeight.at(BPM), song.getBpm(), average, standardDeviation);
+	// The unsigned difference is out of the table for a bpm below the minimal bpm too.
+	unsigned int entry = static_cast<unsigned int>(bpm) - static_cast<unsigned int>(_bpmScoresMin);
+	if (entry < query.bpmScores->size())
+	{
+		return (*query.bpmScores)[entry];
+	}
+	return _likeliHood(_scoreWeight[BPM], bpm, query.knownWord->average,
+					   query.knownWord->standardDeviation);
 }
@@ -2,14 +2,19 @@
 #ifndef SCORER_H_
 #define SCORER_H_
 
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <map>
 #include <string>
+#include "KnownWordsTable.h"
 #include "Song.h"
+#include "SongIndex.h"
 
 const int NO_INSTRUMENT_SCORE = 0;
 const int BPM_SCORE_POWER_CONST = 2;
 const int  BPM_SCORE_DIVISOR_CONST = 2;
+const int MAX_BPM_SCORES_TABLE_SIZE = 1 << 16;
 
 /**
  * A class that defines a scorer used to score songs by a given query.
@@ -28,14 +33,54 @@ class Scorer
 			BPM
 		};
 
+		/**
+		 * The number of scoring parameters.
+		 */
+		static const int NUM_OF_SCORE_PARAMETERS = BPM + 1;
+
+		/**
+		 * A struct that represents a query resolved once before its songs are scored, the term
+		 * of the query and its bpm information in case it is a known word.
+		 */
+		struct PreparedQuery
+		{
+			TermId term; /**< the id of the query, NO_SUCH_TERM if no song has it */
+			const KnownWordsTable::KnownWord *knownWord; /**< the known word of the query, or
+														   nullptr if it is not known */
+			const std::vector<int> *bpmScores; /**< the bpm scores of the known word from the
+												 minimal bpm of the scorer, empty if the
+												 scores are calculated for every song */
+		};
+
 		/**
 		 * The default ctor used to create a Scorer.
 		 * @param scoreWeight the weight of each parameter in the end score.
 		 * @param knownKeywords key words that was previously learned and check to get better
 		 * results.
+		 * @throws std::out_of_range in case the weight of a parameter is missing.
 		 */
 		Scorer(const std::map<ScoreParameters, int> &scoreWeight,
 			   const std::map<std::string, std::pair<double, double> > &knownKeywords);
+
+		/**
+		 * A method that calculates the bpm score of every bpm of a range once for every known
+		 * word, so the songs are scored by a table lookup. The tables are not built for a range
+		 * larger than MAX_BPM_SCORES_TABLE_SIZE or than the number of songs that have a bpm, a
+		 * bpm out of the range is scored by the formula.
+		 * @param minBpm the minimal bpm of the songs to score.
+		 * @param maxBpm the maximal bpm of the songs to score.
+		 * @param numOfBpmSongs the number of songs that have a bpm.
+		 */
+		void prepareBpmScores(int minBpm, int maxBpm, size_t numOfBpmSongs);
+
+		/**
+		 * A method that resolves a query, the result is valid as long as the scorer exists and
+		 * prepareBpmScores is not called again.
+		 * @param query the query.
+		 * @return the prepared query.
+		 */
+		PreparedQuery prepareQuery(const std::string &query) const;
+
 		/**
 		 * A method that returns the score of a given song and query.
 		 * @param song a song to score.
@@ -44,42 +89,83 @@ class Scorer
 		 */
 		int getScore(const Song &song, const std::string &query) const;
 
+		/**
+		 * A method that returns the score of a song by its posting of the query.
+		 * @param posting the posting of the query in the song.
+		 * @param bpm the bpm of the song.
+		 * @param query the prepared query to score.
+		 * @return the total matching score of the song with the given query.
+		 */
+		int getScore(const SongIndex::Posting &posting, int bpm, const PreparedQuery &query) const;
+
+		/**
+		 * A method that returns true iff a word is a known word, so it is scored by the bpm of
+		 * every song that has one.
+		 * @param word the word to check.
+		 * @return true iff the word is known.
+		 */
+		bool isKnownWord(const std::string &word) const;
+
+		/**
+		 * A method that returns the score of a phrase of the lyrics, every occurence of the
+		 * phrase scores as an occurence of a word.
+		 * @param occurences the number of times the phrase occures in the lyrics of the song.
+		 * @return the score of the phrase.
+		 */
+		int getPhraseScore(int occurences) const;
+
+		/**
+		 * A method that returns an upper bound of the bpm score of any song and query.
+		 * @return the maximal bpm score.
+		 */
+		int getMaxBpmScore() const;
+
+		/**
+		 * A method that returns a hash of the scoring parameters, the weights and the known
+		 * words, so results of other parameters can be told apart.
+		 * @return the hash.
+		 */
+		uint64_t getParametersHash() const;
+
 	private:
 		/**
 		 * A methd that calculates the score gained from matched tags.
 		 * @param song a song to score.
-		 * @param tag a tag to score.
+		 * @param tag the id of a tag to score.
 		 * @return the score gained if the tag match.
 		 */
-		int _tagsMatchScore(const Song &song, const std::string &tag) const;
+		int _tagsMatchScore(const Song &song, TermId tag) const;
 
 		/**
 		 * A method that calculates the score gained by a word occurence int the lyrics.
 		 * @param song a song to score.
-		 * @param word a word to score.
+		 * @param word the id of a word to score.
 		 * @return the score gained by the number of occurence of the word in the lyrics.
 		 */
-		int _wordOccurenceScore(const Song &song, const std::string &word) const;
+		int _wordOccurenceScore(const Song &song, TermId word) const;
 
 		/**
 		 * A method that calculates the score gained if a given instrument is used.
 		 * @param song a song to score.
-		 * @param instrument an instrument to score.
+		 * @param instrument the id of an instrument to score.
 		 * @return the score gained if the instrument is used.
 		 */
-		int _instrumentUsedScore(const Song &song, const std::string &instrument) const;
+		int _instrumentUsedScore(const Song &song, TermId instrument) const;
 
 		/**
 		 * A method that calculates the score gained by bpm compatibility with a knownWord.
-		 * @param song a song to score.
-		 * @param knownWord a word to check
+		 * @param bpm the bpm of the song to score.
+		 * @param query the prepared query to check.
 		 * @return the score gained by bpm compatability with the knownWord.
 		 */
-		int _bpmScore(const Song &song, const std::string &knownWord) const;
+		int _bpmScore(int bpm, const PreparedQuery &query) const;
 
-		std::map<ScoreParameters, int> _scoreWeight; /**< a map of the score of each parameter */
-		std::map<std::string, std::pair<double, double> > _knownWords; /**< a map that store the bpm
-																		 information of 
-																		 known words */
+		std::array<int, NUM_OF_SCORE_PARAMETERS> _scoreWeight; /**< the score of each parameter,
+																 by the parameter */
+		KnownWordsTable _knownWords; /**< a table that store the bpm information of known words */
+		int _bpmScoresMin; /**< the bpm of the first score of every table in _bpmScores */
+		std::vector<std::vector<int> > _bpmScores; /**< the bpm scores of every known word, by
+													 its position in _knownWords */
+		uint64_t _parametersHash; /**< the hash of the weights and the known words */
 };
 #endif // Scorer_H_
@@ -0,0 +1,121 @@
+/*
+ * ------------------------------------------------------------------------------------
+ * This file contains the implementation of the SnapshotWriter and SnapshotReader classes
+ * ------------------------------------------------------------------------------------
+ */
+#include <fstream>
+#include "Hash.h"
+#include "Snapshot.h"
+
+/**
+ * A struct that represents the header of a snapshot file, it is followed by the image.
+ */
+struct SnapshotHeader
+{
+	char magic[sizeof(SNAPSHOT_MAGIC)]; /**< SNAPSHOT_MAGIC */
+	uint32_t formatVersion; /**< SNAPSHOT_FORMAT_VERSION */
+	uint64_t imageSize; /**< the number of bytes of the image */
+	uint64_t checksum; /**< the hashWords hash of the image */
+};
+
+/**
+ * A method that writes a string, after its size.
+ * @param str the string.
+ */
+void SnapshotWriter::writeString(const std::string &str)
+{
+	writeValue<uint64_t>(str.size());
+	_image.append(str);
+}
+
+/**
+ * A method that writes the snapshot to a file.
+ * @param fileName the name of the file.
+ * @return true iff the snapshot was written.
+ */
+bool SnapshotWriter::save(const std::string &fileName) const
+{
+	std::ofstream output(fileName.c_str(), std::ios::binary | std::ios::trunc);
+	if (!output.is_open())
+	{
+		return false;
+	}
+
+	SnapshotHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header.formatVersion = SNAPSHOT_FORMAT_VERSION;
+	header.imageSize = _image.size();
+	header.checksum = hashWords(_image.data(), _image.size());
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(_image.data(), _image.size());
+	return static_cast<bool>(output.flush());
+}
+
+/**
+ * The default ctor, creates a reader of no snapshot.
+ */
+SnapshotReader::SnapshotReader() : _position(nullptr), _end(nullptr)
+{
+}
+
+/**
+ * A method that maps a snapshot and checks its header and checksum.
+ * @param fileName the name of the file.
+ * @return true iff the file is a snapshot of this format and is not corrupted.
+ */
+bool SnapshotReader::open(const std::string &fileName)
+{
+	SnapshotHeader header;
+	if (!_file.open(fileName) || _file.size() < sizeof(header))
+	{
+		return false;
+	}
+
+	memcpy(&header, _file.begin(), sizeof(header));
+	_position = _file.begin() + sizeof(header);
+	_end = _file.end();
+	return memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+		   header.formatVersion == SNAPSHOT_FORMAT_VERSION &&
+		   header.imageSize == static_cast<uint64_t>(_end - _position) &&
+		   header.checksum == hashWords(_position, _end - _position);
+}
+
+/**
+ * A method that returns whether a file is a snapshot, by its first bytes.
+ * @param fileName the name of the file.
+ * @return true iff the file starts with SNAPSHOT_MAGIC.
+ */
+bool SnapshotReader::isSnapshot(const std::string &fileName)
+{
+	std::ifstream input(fileName.c_str(), std::ios::binary);
+	char magic[sizeof(SNAPSHOT_MAGIC)];
+	return input.read(magic, sizeof(magic)) &&
+		   memcmp(magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0;
+}
+
+/**
+ * A method that reads a string.
+ * @param str the string to read to.
+ * @return true iff the string was read.
+ */
+bool SnapshotReader::readString(std::string &str)
+{
+	uint64_t size;
+	if (!readValue(size) || size > static_cast<uint64_t>(_end - _position))
+	{
+		return false;
+	}
+	str.assign(_position, size);
+	_position += size;
+	return true;
+}
+
+/**
+ * A method that returns whether the whole snapshot was read.
+ * @return true iff there are no more values to read.
+ */
+bool SnapshotReader::isEnded() const
+{
+	return _position == _end;
+}
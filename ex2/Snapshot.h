@@ -0,0 +1,142 @@
+// Snapshot.h
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+const char SNAPSHOT_MAGIC[4] = {'M', 'I', 'R', 'S'};
+const uint32_t SNAPSHOT_FORMAT_VERSION = 2;
+
+/**
+ * A class that is used to write a snapshot, a binary image of the parsed songs. The values and
+ * the arrays are written in the memory layout of the program, so they are read back by copying.
+ * The image is kept in the memory and written to the file at once, after a header of the
+ * SNAPSHOT_MAGIC, the SNAPSHOT_FORMAT_VERSION, the size of the image and its checksum.
+ */
+class SnapshotWriter
+{
+	public:
+		/**
+		 * A method that writes a value of a plain type.
+		 * @param value the value.
+		 */
+		template<typename T>
+		void writeValue(const T &value)
+		{
+			_image.append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		/**
+		 * A method that writes an array of values of a plain type, after its size.
+		 * @param values the values.
+		 */
+		template<typename T>
+		void writeArray(const std::vector<T> &values)
+		{
+			writeValue<uint64_t>(values.size());
+			_image.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+		}
+
+		/**
+		 * A method that writes a string, after its size.
+		 * @param str the string.
+		 */
+		void writeString(const std::string &str);
+
+		/**
+		 * A method that writes the snapshot to a file.
+		 * @param fileName the name of the file.
+		 * @return true iff the snapshot was written.
+		 */
+		bool save(const std::string &fileName) const;
+
+	private:
+		std::string _image; /**< the written values */
+};
+
+/**
+ * A class that is used to read a snapshot written by SnapshotWriter, the file is mapped to the
+ * memory and the values are copied out of it in the order they were written.
+ */
+class SnapshotReader
+{
+	public:
+		/**
+		 * The default ctor, creates a reader of no snapshot.
+		 */
+		SnapshotReader();
+
+		/**
+		 * A method that maps a snapshot and checks its header and checksum.
+		 * @param fileName the name of the file.
+		 * @return true iff the file is a snapshot of this format and is not corrupted.
+		 */
+		bool open(const std::string &fileName);
+
+		/**
+		 * A method that returns whether a file is a snapshot, by its first bytes.
+		 * @param fileName the name of the file.
+		 * @return true iff the file starts with SNAPSHOT_MAGIC.
+		 */
+		static bool isSnapshot(const std::string &fileName);
+
+		/**
+		 * A method that reads a value of a plain type.
+		 * @param value the value to read to.
+		 * @return true iff the value was read.
+		 */
+		template<typename T>
+		bool readValue(T &value)
+		{
+			if (static_cast<size_t>(_end - _position) < sizeof(T))
+			{
+				return false;
+			}
+			memcpy(&value, _position, sizeof(T));
+			_position += sizeof(T);
+			return true;
+		}
+
+		/**
+		 * A method that reads an array of values of a plain type.
+		 * @param values the vector to read to, its content is replaced.
+		 * @return true iff the array was read.
+		 */
+		template<typename T>
+		bool readArray(std::vector<T> &values)
+		{
+			uint64_t size;
+			if (!readValue(size) || size > static_cast<uint64_t>(_end - _position) / sizeof(T))
+			{
+				return false;
+			}
+			values.resize(size);
+			memcpy(static_cast<void*>(values.data()), _position, size * sizeof(T));
+			_position += size * sizeof(T);
+			return true;
+		}
+
+		/**
+		 * A method that reads a string.
+		 * @param str the string to read to.
+		 * @return true iff the string was read.
+		 */
+		bool readString(std::string &str);
+
+		/**
+		 * A method that returns whether the whole snapshot was read.
+		 * @return true iff there are no more values to read.
+		 */
+		bool isEnded() const;
+
+	private:
+		MappedFile _file; /**< the mapped snapshot */
+		const char *_position; /**< the next value to read */
+		const char *_end; /**< the end of the image */
+};
+
+#endif // SNAPSHOT_H_
@@ -3,16 +3,44 @@
  * This file contains the implementation of the Song class methods
  * ---------------------------------------------------------------
  */
+#include <algorithm>
 #include "Song.h"
 
+/**
+ * A comperator that orders the tags by their id.
+ * @param first the first tag.
+ * @param second the second tag.
+ * @return true iff the id of the first tag is smaller.
+ */
+bool isTagBefore(const std::pair<TermId, int> &first, const std::pair<TermId, int> &second)
+{
+	return first.first < second.first;
+}
+
 /**
 * The default ctor used to create a song.
 * @param title the song title.
-* @param tagsValue the values of all the tags related to the song.
+* @param tagsValue the values of all the tags related to the song, in case a tag appears
+* more than once its last value is kept. The song allocates from its memory resource.
 */
-Song::Song(const std::string &title, const std::map<std::string, int> &tagsValue) : 
-		   _title(title), _tagsValue(tagsValue)
+Song::Song(std::string_view title, TagsValue tagsValue) : 
+		   _title(title, tagsValue.get_allocator()), _tagsValue(std::move(tagsValue))
 {
+	// Sort in place and keep the last value of every tag.
+	std::stable_sort(_tagsValue.begin(), _tagsValue.end(), isTagBefore);
+	TagsValue::iterator last = _tagsValue.begin();
+	for (TagsValue::const_iterator it = _tagsValue.begin(); it != _tagsValue.end(); ++it)
+	{
+		if (last != _tagsValue.begin() && (last - 1)->first == it->first)
+		{
+			(last - 1)->second = it->second;
+		}
+		else
+		{
+			*last++ = *it;
+		}
+	}
+	_tagsValue.erase(last, _tagsValue.end());
 }
 
 /**
@@ -28,7 +56,7 @@ Song::~Song()
 */
 std::string Song::getTitle() const
 {
-	return _title;
+	return std::string(_title);
 }
 
 /**
@@ -38,5 +66,41 @@ std::string Song::getTitle() const
 */
 int Song::tagValue(const std::string &tag) const
 {
-	return ((_tagsValue.find(tag) != _tagsValue.end()) ? _tagsValue.at(tag) : NO_SUCH_TAG);
+	return tagValue(TermDictionary::getInstance().find(tag));
+}
+
+/**
+* A method that returns a given tag value.
+* @param tag the id of the tag to get the value of.
+* @return the tag value.
+*/
+int Song::tagValue(TermId tag) const
+{
+	TagsValue::const_iterator it = std::lower_bound(_tagsValue.begin(), _tagsValue.end(),
+													std::pair<TermId, int>(tag, NO_SUCH_TAG),
+													isTagBefore);
+	return ((it != _tagsValue.end()) && (it->first == tag)) ? it->second : NO_SUCH_TAG;
+}
+
+/**
+* A method that returns all the tags of the song and their values.
+* @return a map from tag to value.
+*/
+std::map<std::string, int> Song::getTagsValue() const
+{
+	std::map<std::string, int> tagsValue;
+	for (TagsValue::const_iterator it = _tagsValue.begin(); it != _tagsValue.end(); ++it)
+	{
+		tagsValue[TermDictionary::getInstance().getTerm(it->first)] = it->second;
+	}
+	return tagsValue;
+}
+
+/**
+* A method that returns all the tags of the song and their values by the tags ids.
+* @return the tags and values, sorted by the tag id.
+*/
+const TagsValue& Song::getTagsTerms() const
+{
+	return _tagsValue;
 }
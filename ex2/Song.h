@@ -4,15 +4,47 @@
 
 #include <string>
 #include <map>
+#include <memory_resource>
+#include <set>
+#include <string_view>
+#include <utility>
 #include <vector>
+#include "TermDictionary.h"
 
 const int NO_SUCH_TAG = 0;
 const int NO_SUCH_WORD = 0;
 const int BPM_UNDEFINED = 0;
 const int NO_INSTRUMENTS_USED = 0;
 
+/**
+ * An enum that defines the kinds of songs.
+ */
+enum SongKind
+{
+	VOCAL,
+	INSTRUMENTAL
+};
+
+/**
+ * The tags of a song, pairs of a tag id and its value.
+ */
+typedef std::pmr::vector<std::pair<TermId, int> > TagsValue;
+
+/**
+ * The words of the lyrics of a song, pairs of a word id and the number of times it occures.
+ */
+typedef std::pmr::vector<std::pair<TermId, int> > WordsOccurence;
+
+/**
+ * The ids of terms of a song, the words of the lyrics or the instruments.
+ */
+typedef std::pmr::vector<TermId> SongTerms;
+
 /**
  * An abstract class that represents a song.
+ * The tags, lyrics and instruments are kept as ids of the TermDictionary. The containers of the
+ * song allocate from the memory resource of its tags, so a song created in a SongArena is kept
+ * entirely in it.
  */
 class Song
 {
@@ -20,9 +52,10 @@ class Song
 		/**
 		 * The default ctor used to create a song.
 		 * @param title the song title.
-		 * @param tagsValue the values of all the tags related to the song.
+		 * @param tagsValue the values of all the tags related to the song, in case a tag appears
+		 * more than once its last value is kept. The song allocates from its memory resource.
 		 */
-		Song(const std::string &title, const std::map<std::string, int> &tagsValue);
+		Song(std::string_view title, TagsValue tagsValue);
 	
 		/**
 		 * A method that is used to return the title of the song.
@@ -37,22 +70,72 @@ class Song
 		 */
 		int tagValue(const std::string &tag) const;
 
+		/**
+		 * A method that returns a given tag value.
+		 * @param tag the id of the tag to get the value of.
+		 * @return the tag value.
+		 */
+		int tagValue(TermId tag) const;
+
+		/**
+		 * A method that returns all the tags of the song and their values.
+		 * @return a map from tag to value.
+		 */
+		std::map<std::string, int> getTagsValue() const;
+
+		/**
+		 * A method that returns all the tags of the song and their values by the tags ids.
+		 * @return the tags and values, sorted by the tag id.
+		 */
+		const TagsValue& getTagsTerms() const;
+
 		/**
 		 * A virtual destructor.
 		 */
 		virtual ~Song();
 
+		/**
+		 * A pure virtual method used to return the kind of the song.
+		 */
+		virtual SongKind getKind() const = 0;
+
 		/**
 		 * A pure virtual method used to return the lyrics of the song.
 		 * 
 		 */
 		virtual std::vector<std::string> getLyrics() const = 0;
 
+		/**
+		 * A pure virtual method used to return the ids of the lyrics words, in the lyrics order.
+		 */
+		virtual const SongTerms& getLyricsTerms() const = 0;
+
+		/**
+		 * A pure virtual method used to return the number of times every word occures in the
+		 * lyrics, sorted by the word id.
+		 */
+		virtual const WordsOccurence& getWordsOccurence() const = 0;
+
+		/**
+		 * A pure virtual method used to return the number of times a word occures in the lyrics.
+		 */
+		virtual int wordOccurence(TermId word) const = 0;
+
 		/**
 		 * A pure virtual method returns true iff an instrument is used in the song.
 		 */
 		virtual bool isInstrumentUsed(const std::string&) const = 0;
 
+		/**
+		 * A pure virtual method returns the instruments used in the song.
+		 */
+		virtual std::set<std::string> getInstruments() const = 0;
+
+		/**
+		 * A pure virtual method returns the ids of the instruments used in the song, sorted.
+		 */
+		virtual const SongTerms& getInstrumentsTerms() const = 0;
+
 		/**
 		 * A pure virtual method returns the bpm of the song.
 		 */
@@ -63,9 +146,8 @@ class Song
 		 */
 		virtual std::string getCreator() const = 0;
 	private:
-		std::string _title; /**< a string represents the title of the song */
-		std::map<std::string, int> _tagsValue; /**< a map contains tags(as keys) 
-												 and their values(as value) */
+		std::pmr::string _title; /**< a string represents the title of the song */
+		TagsValue _tagsValue; /**< the tags ids and their values, sorted by the id */
 };
 
 #endif // SONG_H_
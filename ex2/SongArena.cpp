@@ -0,0 +1,23 @@
+/*
+ * -------------------------------------------------------------------
+ * This file contains the implementation of the SongArena class methods
+ * -------------------------------------------------------------------
+ */
+#include "SongArena.h"
+
+/**
+ * The default ctor, creates an arena with no resources.
+ */
+SongArena::SongArena()
+{
+}
+
+/**
+ * A method that adds a resource to the arena.
+ * @return the resource, it is valid as long as the arena.
+ */
+std::pmr::memory_resource* SongArena::newResource()
+{
+	_resources.emplace_back(new std::pmr::monotonic_buffer_resource(ARENA_INITIAL_BLOCK_SIZE));
+	return _resources.back().get();
+}
@@ -0,0 +1,57 @@
+// SongArena.h
+#ifndef SONG_ARENA_H_
+#define SONG_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+const size_t ARENA_INITIAL_BLOCK_SIZE = 1 << 20;
+
+/**
+ * A class that represents the memory of parsed songs, the songs and their containers are
+ * allocated from monotonic buffers that grow by large blocks and are released at once when the
+ * arena is destroyed. The songs are never destroyed one by one, so every container of a song must
+ * allocate from the resource the song was created with.
+ * A resource must not be used by several threads at once, so every parsing thread gets its own.
+ */
+class SongArena
+{
+	public:
+		/**
+		 * The default ctor, creates an arena with no resources.
+		 */
+		SongArena();
+
+		SongArena(const SongArena&) = delete;
+		SongArena& operator=(const SongArena&) = delete;
+
+		/**
+		 * A method that adds a resource to the arena, it should not be called by several threads
+		 * at once.
+		 * @return the resource, it is valid as long as the arena.
+		 */
+		std::pmr::memory_resource* newResource();
+
+		/**
+		 * A method that creates an object in a resource of the arena.
+		 * @param resource the resource to allocate the object from.
+		 * @param args the arguments of the ctor of the object.
+		 * @return the object, it is valid as long as the arena.
+		 */
+		template<typename T, typename... Args>
+		static T* create(std::pmr::memory_resource *resource, Args&&... args)
+		{
+			void *memory = resource->allocate(sizeof(T), alignof(T));
+			return new (memory) T(std::forward<Args>(args)...);
+		}
+
+	private:
+		std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource> > _resources; /**< the
+																						  buffers */
+};
+
+#endif // SONG_ARENA_H_
@@ -0,0 +1,394 @@
+/*
+ * ----------------------------------------------------------------------
+ * This file contains the implementation of the SongCatalog class methods
+ * ----------------------------------------------------------------------
+ */
+#include "Hash.h"
+#include "SongCatalog.h"
+
+// The seeds of the hashes of the kinds of terms, so a tag is not hashed as a lyrics word.
+const int TAGS_SEED = 1;
+const int LYRICS_SEED = 2;
+const int INSTRUMENTS_SEED = 3;
+const int LYRICS_ORDER_SEED = 4;
+
+/**
+ * A function that is used to hash a string and a number, the string is hashed with its size so
+ * it is separated from the next bytes.
+ * @param str the string.
+ * @param number the number.
+ * @param hash the hash of the previous bytes.
+ * @return the hash.
+ */
+uint64_t hashField(std::string_view str, int number, uint64_t hash = FNV_OFFSET_BASIS)
+{
+	uint64_t size = str.size();
+	hash = hashBytes(&size, sizeof(size), hash);
+	hash = hashBytes(str.data(), str.size(), hash);
+	return hashBytes(&number, sizeof(number), hash);
+}
+
+/**
+ * A function that is used to hash the terms of a song, the term ids depend on the order the
+ * terms were interned in, so the terms are hashed by their strings and summed, which does not
+ * depend on their order.
+ * @param terms the terms and a number of every term.
+ * @param seed a number that separates the kinds of terms.
+ * @return the hash.
+ */
+uint64_t hashTerms(SongCatalog::Range<std::pair<TermId, int> > terms, int seed)
+{
+	uint64_t hash = 0;
+	for (const std::pair<TermId, int> &term : terms)
+	{
+		hash += hashField(TermDictionary::getInstance().getTerm(term.first), term.second,
+						  hashBytes(&seed, sizeof(seed)));
+	}
+	return hash;
+}
+
+/**
+ * The default ctor, creates an empty catalog.
+ */
+SongCatalog::SongCatalog() : _titlesBegin(1, 0), _creatorsBegin(1, 0), _minBpm(BPM_UNDEFINED),
+							 _maxBpm(BPM_UNDEFINED), _tagsBegin(1, 0),
+							 _lyricsBegin(1, 0), _lyricsWordsBegin(1, 0), _instrumentsBegin(1, 0),
+							 _version(FNV_OFFSET_BASIS), _isVersionValid(true)
+{
+}
+
+/**
+ * A ctor that creates the catalog of given songs, the songs are not needed after it.
+ * @param songs the songs, their positions are their positions in the catalog.
+ */
+SongCatalog::SongCatalog(const std::vector<Song*> &songs) : SongCatalog()
+{
+	// The version is calculated when it is first needed.
+	_isVersionValid = false;
+	_titlesBegin.reserve(songs.size() + 1);
+	_creatorsBegin.reserve(songs.size() + 1);
+	_kinds.reserve(songs.size());
+	_bpms.reserve(songs.size());
+	_isRemoved.reserve(songs.size());
+	for (std::vector<Song*>::const_iterator it = songs.begin(); it != songs.end(); ++it)
+	{
+		addSong(**it);
+	}
+}
+
+/**
+ * A method that adds a song to the end of the catalog.
+ * @param song the song to add.
+ */
+void SongCatalog::addSong(const Song &song)
+{
+	_titles.append(song.getTitle());
+	_titlesBegin.push_back(_titles.size());
+	_creators.append(song.getCreator());
+	_creatorsBegin.push_back(_creators.size());
+	_kinds.push_back(song.getKind());
+	int bpm = song.getBpm();
+	_bpms.push_back(bpm);
+	_isRemoved.push_back(false);
+	if (bpm != BPM_UNDEFINED)
+	{
+		bool isFirstBpm = (_minBpm == BPM_UNDEFINED);
+		_minBpm = (isFirstBpm || bpm < _minBpm) ? bpm : _minBpm;
+		_maxBpm = (isFirstBpm || bpm > _maxBpm) ? bpm : _maxBpm;
+	}
+
+	const TagsValue &tags = song.getTagsTerms();
+	_tags.insert(_tags.end(), tags.begin(), tags.end());
+	_tagsBegin.push_back(_tags.size());
+
+	const WordsOccurence &words = song.getWordsOccurence();
+	_lyricsCounts.insert(_lyricsCounts.end(), words.begin(), words.end());
+	_lyricsBegin.push_back(_lyricsCounts.size());
+	const SongTerms &lyrics = song.getLyricsTerms();
+	_lyricsWords.insert(_lyricsWords.end(), lyrics.begin(), lyrics.end());
+	_lyricsWordsBegin.push_back(_lyricsWords.size());
+
+	const SongTerms &instruments = song.getInstrumentsTerms();
+	_instruments.insert(_instruments.end(), instruments.begin(), instruments.end());
+	_instrumentsBegin.push_back(_instruments.size());
+	if (_isVersionValid)
+	{
+		_version += _positionHash(size() - 1);
+	}
+}
+
+/**
+ * A method that removes a song, the song keeps its position so the positions of the other songs
+ * do not change. The bpm range is not narrowed, it only bounds the bpms of the songs.
+ * @param song the position of the song.
+ */
+void SongCatalog::removeSong(unsigned int song)
+{
+	if (_isVersionValid)
+	{
+		_version -= _positionHash(song);
+	}
+	_isRemoved[song] = true;
+}
+
+/**
+ * A method that returns whether a song was removed.
+ * @param song the position of the song.
+ * @return true iff the song was removed.
+ */
+bool SongCatalog::isRemoved(unsigned int song) const
+{
+	return _isRemoved[song];
+}
+
+/**
+ * A method that returns the songs of a title.
+ * @param title the title.
+ * @return the positions of the songs of the title that were not removed, sorted.
+ */
+std::vector<unsigned int> SongCatalog::findSongs(const std::string &title) const
+{
+	std::vector<unsigned int> songs;
+	for (unsigned int song = 0; song < size(); song++)
+	{
+		if (!_isRemoved[song] && getTitle(song) == title)
+		{
+			songs.push_back(song);
+		}
+	}
+	return songs;
+}
+
+/**
+ * A method that returns the number of songs, including the removed songs.
+ * @return the number of songs.
+ */
+unsigned int SongCatalog::size() const
+{
+	return _kinds.size();
+}
+
+/**
+ * A method that returns the version of the catalog, a hash of its songs that changes
+ * whenever the catalog changes and is the same for the same songs in every run. It is the sum of
+ * the hashes of the songs and their positions(the removed songs are skipped), so once it is
+ * calculated it is updated by every added or removed song without hashing the other songs.
+ * @return the version.
+ */
+uint64_t SongCatalog::getVersion() const
+{
+	if (!_isVersionValid)
+	{
+		_version = FNV_OFFSET_BASIS;
+		for (unsigned int song = 0; song < size(); song++)
+		{
+			if (!_isRemoved[song])
+			{
+				_version += _positionHash(song);
+			}
+		}
+		_isVersionValid = true;
+	}
+	return _version;
+}
+
+/**
+ * A method that writes the catalog, with its version, to a snapshot.
+ * @param snapshot the snapshot to write to.
+ */
+void SongCatalog::save(SnapshotWriter &snapshot) const
+{
+	snapshot.writeArray(_titlesBegin);
+	snapshot.writeString(_titles);
+	snapshot.writeArray(_creatorsBegin);
+	snapshot.writeString(_creators);
+	snapshot.writeArray(_kinds);
+	snapshot.writeArray(_bpms);
+	snapshot.writeArray(_isRemoved);
+	snapshot.writeValue(_minBpm);
+	snapshot.writeValue(_maxBpm);
+	snapshot.writeArray(_tagsBegin);
+	snapshot.writeArray(_tags);
+	snapshot.writeArray(_lyricsBegin);
+	snapshot.writeArray(_lyricsCounts);
+	snapshot.writeArray(_lyricsWordsBegin);
+	snapshot.writeArray(_lyricsWords);
+	snapshot.writeArray(_instrumentsBegin);
+	snapshot.writeArray(_instruments);
+	snapshot.writeValue(getVersion());
+}
+
+/**
+ * A method that reads the catalog of a snapshot, instead of its songs.
+ * @param snapshot the snapshot to read from.
+ * @return true iff a catalog was read.
+ */
+bool SongCatalog::load(SnapshotReader &snapshot)
+{
+	if (!snapshot.readArray(_titlesBegin) || !snapshot.readString(_titles) ||
+		!snapshot.readArray(_creatorsBegin) || !snapshot.readString(_creators) ||
+		!snapshot.readArray(_kinds) || !snapshot.readArray(_bpms) ||
+		!snapshot.readArray(_isRemoved) || !snapshot.readValue(_minBpm) ||
+		!snapshot.readValue(_maxBpm) || !snapshot.readArray(_tagsBegin) ||
+		!snapshot.readArray(_tags) || !snapshot.readArray(_lyricsBegin) ||
+		!snapshot.readArray(_lyricsCounts) || !snapshot.readArray(_lyricsWordsBegin) ||
+		!snapshot.readArray(_lyricsWords) || !snapshot.readArray(_instrumentsBegin) ||
+		!snapshot.readArray(_instruments) || !snapshot.readValue(_version))
+	{
+		return false;
+	}
+	_isVersionValid = true;
+
+	// The ranges of every song must be in the flat arrays.
+	size_t numOfSongs = _kinds.size();
+	return _titlesBegin.size() == numOfSongs + 1 &&
+		   _titlesBegin.back() == _titles.size() && _creatorsBegin.size() == numOfSongs + 1 &&
+		   _creatorsBegin.back() == _creators.size() && _bpms.size() == numOfSongs &&
+		   _isRemoved.size() == numOfSongs && _tagsBegin.size() == numOfSongs + 1 &&
+		   _tagsBegin.back() == _tags.size() && _lyricsBegin.size() == numOfSongs + 1 &&
+		   _lyricsBegin.back() == _lyricsCounts.size() &&
+		   _lyricsWordsBegin.size() == numOfSongs + 1 &&
+		   _lyricsWordsBegin.back() == _lyricsWords.size() &&
+		   _instrumentsBegin.size() == numOfSongs + 1 &&
+		   _instrumentsBegin.back() == _instruments.size();
+}
+
+/**
+ * A method that returns the hash of a song and its position, the results refer to the songs by
+ * their positions.
+ * @param song the position of the song.
+ * @return the hash.
+ */
+uint64_t SongCatalog::_positionHash(unsigned int song) const
+{
+	uint64_t songHash = _songHash(song);
+	return hashBytes(&song, sizeof(song), hashBytes(&songHash, sizeof(songHash)));
+}
+
+/**
+ * A method that returns the hash of a song.
+ * @param song the position of the song.
+ * @return the hash.
+ */
+uint64_t SongCatalog::_songHash(unsigned int song) const
+{
+	uint64_t hash = hashField(getTitle(song), _kinds[song], hashField(getCreator(song), _bpms[song]));
+	hash += hashTerms(getTags(song), TAGS_SEED) + hashTerms(getLyricsCounts(song), LYRICS_SEED);
+	for (TermId instrument : getInstruments(song))
+	{
+		hash += hashField(TermDictionary::getInstance().getTerm(instrument), INSTRUMENTS_SEED);
+	}
+
+	// The counts do not tell the order of the lyrics, which the phrases are matched by.
+	uint64_t orderHash = hashBytes(&LYRICS_ORDER_SEED, sizeof(LYRICS_ORDER_SEED));
+	for (TermId word : getLyricsWords(song))
+	{
+		orderHash = hashField(TermDictionary::getInstance().getTerm(word), LYRICS_ORDER_SEED,
+							  orderHash);
+	}
+	return hash + orderHash;
+}
+
+/**
+ * A method that returns the kind of a song.
+ * @param song the position of the song.
+ * @return the kind of the song.
+ */
+SongKind SongCatalog::getKind(unsigned int song) const
+{
+	return _kinds[song];
+}
+
+/**
+ * A method that returns the bpm of a song.
+ * @param song the position of the song.
+ * @return the bpm of the song, BPM_UNDEFINED if it has none.
+ */
+int SongCatalog::getBpm(unsigned int song) const
+{
+	return _bpms[song];
+}
+
+/**
+ * A method that returns the minimal bpm of the songs that have a bpm.
+ * @return the minimal bpm, BPM_UNDEFINED if no song has a bpm.
+ */
+int SongCatalog::getMinBpm() const
+{
+	return _minBpm;
+}
+
+/**
+ * A method that returns the maximal bpm of the songs that have a bpm.
+ * @return the maximal bpm, BPM_UNDEFINED if no song has a bpm.
+ */
+int SongCatalog::getMaxBpm() const
+{
+	return _maxBpm;
+}
+
+/**
+ * A method that returns the title of a song.
+ * @param song the position of the song.
+ * @return the song title.
+ */
+std::string_view SongCatalog::getTitle(unsigned int song) const
+{
+	return std::string_view(_titles).substr(_titlesBegin[song],
+											 _titlesBegin[song + 1] - _titlesBegin[song]);
+}
+
+/**
+ * A method that returns the creator of a song, as Song::getCreator.
+ * @param song the position of the song.
+ * @return the creator of the song.
+ */
+std::string_view SongCatalog::getCreator(unsigned int song) const
+{
+	return std::string_view(_creators).substr(_creatorsBegin[song],
+											   _creatorsBegin[song + 1] - _creatorsBegin[song]);
+}
+
+/**
+ * A method that returns the tags of a song.
+ * @param song the position of the song.
+ * @return the tags ids and values, sorted by the id.
+ */
+SongCatalog::Range<std::pair<TermId, int> > SongCatalog::getTags(unsigned int song) const
+{
+	return Range<std::pair<TermId, int> >(_tags.data() + _tagsBegin[song],
+										  _tags.data() + _tagsBegin[song + 1]);
+}
+
+/**
+ * A method that returns the lyrics words counts of a song.
+ * @param song the position of the song.
+ * @return the words ids and the number of times they occure, sorted by the id.
+ */
+SongCatalog::Range<SongCatalog::TermCount> SongCatalog::getLyricsCounts(unsigned int song) const
+{
+	return Range<TermCount>(_lyricsCounts.data() + _lyricsBegin[song],
+							_lyricsCounts.data() + _lyricsBegin[song + 1]);
+}
+
+/**
+ * A method that returns the lyrics words of a song, used to match phrases.
+ * @param song the position of the song.
+ * @return the words ids, in the order of the lyrics.
+ */
+SongCatalog::Range<TermId> SongCatalog::getLyricsWords(unsigned int song) const
+{
+	return Range<TermId>(_lyricsWords.data() + _lyricsWordsBegin[song],
+						 _lyricsWords.data() + _lyricsWordsBegin[song + 1]);
+}
+
+/**
+ * A method that returns the instruments of a song.
+ * @param song the position of the song.
+ * @return the instruments ids, sorted.
+ */
+SongCatalog::Range<TermId> SongCatalog::getInstruments(unsigned int song) const
+{
+	return Range<TermId>(_instruments.data() + _instrumentsBegin[song],
+						 _instruments.data() + _instrumentsBegin[song + 1]);
+}
@@ -0,0 +1,244 @@
+// SongCatalog.h
+#ifndef SONG_CATALOG_H_
+#define SONG_CATALOG_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Song.h"
+
+/**
+ * A class that represents the songs as a columnar catalog, every property of the songs is kept in
+ * a contiguous array indexed by the song position, and the tags, lyrics and instruments of all
+ * the songs are kept in flat arrays with the offset of every song. Unlike the Song objects it is
+ * read without pointer chasing or virtual calls.
+ */
+class SongCatalog
+{
+	public:
+		/**
+		 * A struct that represents the number of times a term occures in the lyrics of a song.
+		 */
+		typedef std::pair<TermId, int> TermCount;
+
+		/**
+		 * A class that represents a range of a flat array of the catalog.
+		 */
+		template<typename T>
+		class Range
+		{
+			public:
+				/**
+				 * A ctor that creates the range [begin, end).
+				 * @param begin the first element.
+				 * @param end past the last element.
+				 */
+				Range(const T *begin, const T *end) : _begin(begin), _end(end)
+				{
+				}
+
+				/**
+				 * A method that returns the beginning of the range.
+				 * @return a pointer to the first element.
+				 */
+				const T* begin() const
+				{
+					return _begin;
+				}
+
+				/**
+				 * A method that returns the end of the range.
+				 * @return a pointer past the last element.
+				 */
+				const T* end() const
+				{
+					return _end;
+				}
+
+			private:
+				const T *_begin; /**< the first element */
+				const T *_end; /**< past the last element */
+		};
+
+		/**
+		 * The default ctor, creates an empty catalog.
+		 */
+		SongCatalog();
+
+		/**
+		 * A ctor that creates the catalog of given songs, the songs are not needed after it.
+		 * @param songs the songs, their positions are their positions in the catalog.
+		 */
+		explicit SongCatalog(const std::vector<Song*> &songs);
+
+		/**
+		 * A method that adds a song to the end of the catalog.
+		 * @param song the song to add.
+		 */
+		void addSong(const Song &song);
+
+		/**
+		 * A method that removes a song, the song keeps its position(and its memory, until the
+		 * catalog is rebuilt) so the positions of the other songs do not change.
+		 * @param song the position of the song.
+		 */
+		void removeSong(unsigned int song);
+
+		/**
+		 * A method that returns whether a song was removed.
+		 * @param song the position of the song.
+		 * @return true iff the song was removed.
+		 */
+		bool isRemoved(unsigned int song) const;
+
+		/**
+		 * A method that returns the songs of a title.
+		 * @param title the title.
+		 * @return the positions of the songs of the title that were not removed, sorted.
+		 */
+		std::vector<unsigned int> findSongs(const std::string &title) const;
+
+		/**
+		 * A method that returns the number of songs, including the removed songs.
+		 * @return the number of songs.
+		 */
+		unsigned int size() const;
+
+		/**
+		 * A method that returns the kind of a song.
+		 * @param song the position of the song.
+		 * @return the kind of the song.
+		 */
+		SongKind getKind(unsigned int song) const;
+
+		/**
+		 * A method that returns the bpm of a song.
+		 * @param song the position of the song.
+		 * @return the bpm of the song, BPM_UNDEFINED if it has none.
+		 */
+		int getBpm(unsigned int song) const;
+
+		/**
+		 * A method that returns the minimal bpm of the songs that have a bpm, the removed songs
+		 * may be included.
+		 * @return the minimal bpm, BPM_UNDEFINED if no song has a bpm.
+		 */
+		int getMinBpm() const;
+
+		/**
+		 * A method that returns the maximal bpm of the songs that have a bpm, the removed songs
+		 * may be included.
+		 * @return the maximal bpm, BPM_UNDEFINED if no song has a bpm.
+		 */
+		int getMaxBpm() const;
+
+		/**
+		 * A method that returns the title of a song.
+		 * @param song the position of the song.
+		 * @return the song title.
+		 */
+		std::string_view getTitle(unsigned int song) const;
+
+		/**
+		 * A method that returns the creator of a song, as Song::getCreator.
+		 * @param song the position of the song.
+		 * @return the creator of the song.
+		 */
+		std::string_view getCreator(unsigned int song) const;
+
+		/**
+		 * A method that returns the tags of a song.
+		 * @param song the position of the song.
+		 * @return the tags ids and values, sorted by the id.
+		 */
+		Range<std::pair<TermId, int> > getTags(unsigned int song) const;
+
+		/**
+		 * A method that returns the lyrics words counts of a song.
+		 * @param song the position of the song.
+		 * @return the words ids and the number of times they occure, sorted by the id.
+		 */
+		Range<TermCount> getLyricsCounts(unsigned int song) const;
+
+		/**
+		 * A method that returns the lyrics words of a song, used to match phrases.
+		 * @param song the position of the song.
+		 * @return the words ids, in the order of the lyrics.
+		 */
+		Range<TermId> getLyricsWords(unsigned int song) const;
+
+		/**
+		 * A method that returns the instruments of a song.
+		 * @param song the position of the song.
+		 * @return the instruments ids, sorted.
+		 */
+		Range<TermId> getInstruments(unsigned int song) const;
+
+		/**
+		 * A method that returns the version of the catalog, a hash of its songs that changes
+		 * whenever the catalog changes and is the same for the same songs in every run. It is
+		 * calculated on the first call and then updated by every change, so it should not be
+		 * called by several threads at once.
+		 * @return the version.
+		 */
+		uint64_t getVersion() const;
+
+		/**
+		 * A method that writes the catalog, with its version, to a snapshot.
+		 * @param snapshot the snapshot to write to.
+		 */
+		void save(SnapshotWriter &snapshot) const;
+
+		/**
+		 * A method that reads the catalog of a snapshot, instead of its songs.
+		 * @param snapshot the snapshot to read from.
+		 * @return true iff a catalog was read.
+		 */
+		bool load(SnapshotReader &snapshot);
+
+	private:
+		/**
+		 * A method that returns the hash of a song.
+		 * @param song the position of the song.
+		 * @return the hash.
+		 */
+		uint64_t _songHash(unsigned int song) const;
+
+		/**
+		 * A method that returns the hash of a song and its position.
+		 * @param song the position of the song.
+		 * @return the hash.
+		 */
+		uint64_t _positionHash(unsigned int song) const;
+
+		std::vector<unsigned int> _titlesBegin; /**< the offset of the title of every song, and the
+												  end of the titles at the end */
+		std::string _titles; /**< the titles of all the songs */
+		std::vector<unsigned int> _creatorsBegin; /**< the offset of the creator of every song, and
+													the end of the creators at the end */
+		std::string _creators; /**< the creators of all the songs */
+		std::vector<SongKind> _kinds; /**< the kind of every song */
+		std::vector<int> _bpms; /**< the bpm of every song */
+		std::vector<char> _isRemoved; /**< true for every removed song */
+		int _minBpm; /**< the minimal defined bpm */
+		int _maxBpm; /**< the maximal defined bpm */
+		std::vector<unsigned int> _tagsBegin; /**< the offset of the tags of every song, and the
+												end of the tags at the end */
+		std::vector<std::pair<TermId, int> > _tags; /**< the tags of all the songs */
+		std::vector<unsigned int> _lyricsBegin; /**< the offset of the lyrics counts of every song,
+												  and the end of the counts at the end */
+		std::vector<TermCount> _lyricsCounts; /**< the lyrics counts of all the songs */
+		std::vector<unsigned int> _lyricsWordsBegin; /**< the offset of the lyrics words of every
+													   song, and the end of the words at the end */
+		std::vector<TermId> _lyricsWords; /**< the lyrics words of all the songs, in order */
+		std::vector<unsigned int> _instrumentsBegin; /**< the offset of the instruments of every
+													   song, and the end of them at the end */
+		std::vector<TermId> _instruments; /**< the instruments of all the songs */
+		mutable uint64_t _version; /**< the hash of the songs */
+		mutable bool _isVersionValid; /**< true iff the hash was calculated, and then it is
+										updated by every change */
+};
+
+#endif // SONG_CATALOG_H_
@@ -0,0 +1,203 @@
+/*
+ * --------------------------------------------------------------------
+ * This file contains the implementation of the SongIndex class methods
+ * --------------------------------------------------------------------
+ */
+#include <algorithm>
+#include "SongIndex.h"
+
+/**
+ * A comperator used to binary search the postings of a term by the song position.
+ * @param posting the posting.
+ * @param song the position of the song.
+ * @return true iff the posting is of a song before the given song.
+ */
+bool isPostingBefore(const SongIndex::Posting &posting, unsigned int song)
+{
+	return posting.song < song;
+}
+
+/**
+ * The default ctor, creates an empty index.
+ */
+SongIndex::SongIndex()
+{
+}
+
+/**
+ * A ctor used to build the index of the songs of a catalog.
+ * @param catalog the songs to index.
+ */
+SongIndex::SongIndex(const SongCatalog &catalog)
+{
+	_postings.resize(TermDictionary::getInstance().size());
+	for (unsigned int song = 0; song < catalog.size(); song++)
+	{
+		if (!catalog.isRemoved(song))
+		{
+			addSong(catalog, song);
+		}
+	}
+}
+
+/**
+ * A method that indexes a song added to the catalog, it should be after every indexed song.
+ * @param catalog the catalog of the song.
+ * @param song the position of the song.
+ */
+void SongIndex::addSong(const SongCatalog &catalog, unsigned int song)
+{
+	// The song may have terms that were interned after the index was built.
+	if (_postings.size() < TermDictionary::getInstance().size())
+	{
+		_postings.resize(TermDictionary::getInstance().size());
+	}
+
+	for (const std::pair<TermId, int> &tag : catalog.getTags(song))
+	{
+		_posting(tag.first, song).tagValue = tag.second;
+	}
+	for (const SongCatalog::TermCount &word : catalog.getLyricsCounts(song))
+	{
+		_posting(word.first, song).lyricsCount = word.second;
+	}
+	for (TermId instrument : catalog.getInstruments(song))
+	{
+		_posting(instrument, song).instrumentUsed = true;
+	}
+
+	if (catalog.getBpm(song) != BPM_UNDEFINED)
+	{
+		_bpmSongs.push_back(song);
+	}
+}
+
+/**
+ * A method that removes the postings of a song, so it is not found by any term.
+ * @param catalog the catalog of the song.
+ * @param song the position of the song.
+ */
+void SongIndex::removeSong(const SongCatalog &catalog, unsigned int song)
+{
+	for (const std::pair<TermId, int> &tag : catalog.getTags(song))
+	{
+		_removePosting(tag.first, song);
+	}
+	for (const SongCatalog::TermCount &word : catalog.getLyricsCounts(song))
+	{
+		_removePosting(word.first, song);
+	}
+	for (TermId instrument : catalog.getInstruments(song))
+	{
+		_removePosting(instrument, song);
+	}
+
+	std::vector<unsigned int>::iterator it = std::lower_bound(_bpmSongs.begin(), _bpmSongs.end(),
+															  song);
+	if (it != _bpmSongs.end() && *it == song)
+	{
+		_bpmSongs.erase(it);
+	}
+}
+
+/**
+ * A method that removes the posting of a term in a song, in case there is one.
+ * @param term the id of the term.
+ * @param song the position of the song.
+ */
+void SongIndex::_removePosting(TermId term, unsigned int song)
+{
+	std::vector<Posting> &postings = _postings[term];
+	std::vector<Posting>::iterator it = std::lower_bound(postings.begin(), postings.end(), song,
+														 isPostingBefore);
+	if (it != postings.end() && it->song == song)
+	{
+		postings.erase(it);
+	}
+}
+
+/**
+ * A method that returns the posting of a term in a song, the song should be the last
+ * song indexed.
+ * @param term the id of the term.
+ * @param song the position of the song.
+ * @return a reference to the posting, a new one if the term was not seen in the song yet.
+ */
+SongIndex::Posting& SongIndex::_posting(TermId term, unsigned int song)
+{
+	std::vector<Posting> &postings = _postings[term];
+	if (postings.empty() || postings.back().song != song)
+	{
+		Posting posting = {song, NO_SUCH_TAG, NO_SUCH_WORD, false};
+		postings.push_back(posting);
+	}
+	return postings.back();
+}
+
+/**
+ * A method that returns the postings of a term.
+ * @param term the term to get the postings of.
+ * @return the postings of the songs the term appears at, sorted by the song position.
+ */
+const std::vector<SongIndex::Posting>& SongIndex::getPostings(const std::string &term) const
+{
+	return getPostings(TermDictionary::getInstance().find(term));
+}
+
+/**
+ * A method that returns the postings of a term.
+ * @param term the id of the term to get the postings of.
+ * @return the postings of the songs the term appears at, sorted by the song position.
+ */
+const std::vector<SongIndex::Posting>& SongIndex::getPostings(TermId term) const
+{
+	static const std::vector<Posting> noPostings;
+	return (term < _postings.size()) ? _postings[term] : noPostings;
+}
+
+/**
+ * A method that returns the songs that have a bpm.
+ * @return the positions of the songs that their bpm is defined, sorted.
+ */
+const std::vector<unsigned int>& SongIndex::getBpmSongs() const
+{
+	return _bpmSongs;
+}
+
+
+/**
+ * A method that writes the index to a snapshot.
+ * @param snapshot the snapshot to write to.
+ */
+void SongIndex::save(SnapshotWriter &snapshot) const
+{
+	snapshot.writeValue<uint64_t>(_postings.size());
+	for (const std::vector<Posting> &postings : _postings)
+	{
+		snapshot.writeArray(postings);
+	}
+	snapshot.writeArray(_bpmSongs);
+}
+
+/**
+ * A method that reads the index of a snapshot, instead of its postings.
+ * @param snapshot the snapshot to read from.
+ * @return true iff an index was read.
+ */
+bool SongIndex::load(SnapshotReader &snapshot)
+{
+	uint64_t numOfTerms;
+	if (!snapshot.readValue(numOfTerms) || numOfTerms > TermDictionary::getInstance().size())
+	{
+		return false;
+	}
+	_postings.resize(numOfTerms);
+	for (std::vector<Posting> &postings : _postings)
+	{
+		if (!snapshot.readArray(postings))
+		{
+			return false;
+		}
+	}
+	return snapshot.readArray(_bpmSongs);
+}
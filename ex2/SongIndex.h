@@ -0,0 +1,110 @@
+// SongIndex.h
+#ifndef SONG_INDEX_H_
+#define SONG_INDEX_H_
+
+#include <string>
+#include <vector>
+#include "SongCatalog.h"
+
+/**
+ * A class that represents an inverted index over the songs, it maps every term that appears as a
+ * tag, a lyrics word or an instrument of a song to the postings of the songs it appears at, so a
+ * query only touches the songs it matches.
+ * The songs are identified by their position in the catalog the index was built from.
+ */
+class SongIndex
+{
+	public:
+		/**
+		 * A struct that represents the appearance of a term in a single song.
+		 */
+		struct Posting
+		{
+			unsigned int song; /**< the position of the song */
+			int tagValue; /**< the value of the term as a tag of the song */
+			int lyricsCount; /**< the number of times the term occures in the lyrics */
+			bool instrumentUsed; /**< true iff the term is an instrument used in the song */
+		};
+
+		/**
+		 * The default ctor, creates an empty index.
+		 */
+		SongIndex();
+
+		/**
+		 * A ctor used to build the index of the songs of a catalog.
+		 * @param catalog the songs to index.
+		 */
+		explicit SongIndex(const SongCatalog &catalog);
+
+		/**
+		 * A method that indexes a song added to the catalog, it should be after every indexed
+		 * song.
+		 * @param catalog the catalog of the song.
+		 * @param song the position of the song.
+		 */
+		void addSong(const SongCatalog &catalog, unsigned int song);
+
+		/**
+		 * A method that removes the postings of a song, so it is not found by any term.
+		 * @param catalog the catalog of the song.
+		 * @param song the position of the song.
+		 */
+		void removeSong(const SongCatalog &catalog, unsigned int song);
+
+		/**
+		 * A method that returns the postings of a term.
+		 * @param term the term to get the postings of.
+		 * @return the postings of the songs the term appears at, sorted by the song position.
+		 */
+		const std::vector<Posting>& getPostings(const std::string &term) const;
+
+		/**
+		 * A method that returns the postings of a term.
+		 * @param term the id of the term to get the postings of.
+		 * @return the postings of the songs the term appears at, sorted by the song position.
+		 */
+		const std::vector<Posting>& getPostings(TermId term) const;
+
+		/**
+		 * A method that returns the songs that have a bpm.
+		 * @return the positions of the songs that their bpm is defined, sorted.
+		 */
+		const std::vector<unsigned int>& getBpmSongs() const;
+
+		/**
+		 * A method that writes the index to a snapshot.
+		 * @param snapshot the snapshot to write to.
+		 */
+		void save(SnapshotWriter &snapshot) const;
+
+		/**
+		 * A method that reads the index of a snapshot, instead of its postings.
+		 * @param snapshot the snapshot to read from.
+		 * @return true iff an index was read.
+		 */
+		bool load(SnapshotReader &snapshot);
+
+	private:
+		/**
+		 * A method that returns the posting of a term in a song, the song should be the last
+		 * song indexed.
+		 * @param term the id of the term.
+		 * @param song the position of the song.
+		 * @return a reference to the posting, a new one if the term was not seen in the song yet.
+		 */
+		Posting& _posting(TermId term, unsigned int song);
+
+		/**
+		 * A method that removes the posting of a term in a song, in case there is one.
+		 * @param term the id of the term.
+		 * @param song the position of the song.
+		 */
+		void _removePosting(TermId term, unsigned int song);
+
+		std::vector<std::vector<Posting> > _postings; /**< the postings of every term, by the term
+														id */
+		std::vector<unsigned int> _bpmSongs; /**< the positions of the songs with a bpm */
+};
+
+#endif // SONG_INDEX_H_
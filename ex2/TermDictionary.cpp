@@ -0,0 +1,109 @@
+/*
+ * -------------------------------------------------------------------------
+ * This file contains the implementation of the TermDictionary class methods
+ * -------------------------------------------------------------------------
+ */
+#include "TermDictionary.h"
+
+/**
+ * The default ctor, creates an empty dictionary.
+ */
+TermDictionary::TermDictionary()
+{
+}
+
+/**
+ * A method that returns the dictionary of the program.
+ * @return the single instance of the dictionary.
+ */
+TermDictionary& TermDictionary::getInstance()
+{
+	static TermDictionary dictionary;
+	return dictionary;
+}
+
+/**
+ * A method that returns the id of a term, the term is added in case it is new.
+ * @param term the term.
+ * @return the id of the term.
+ */
+TermId TermDictionary::intern(std::string_view term)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::unordered_map<std::string_view, TermId>::const_iterator it = _ids.find(term);
+	if (it != _ids.end())
+	{
+		return it->second;
+	}
+	TermId id = _terms.size();
+	_terms.emplace_back(term);
+	_ids.emplace(_terms.back(), id);
+	return id;
+}
+
+/**
+ * A method that returns the id of a term without adding it.
+ * @param term the term.
+ * @return the id of the term, or NO_SUCH_TERM in case it was never interned.
+ */
+TermId TermDictionary::find(std::string_view term) const
+{
+	std::unordered_map<std::string_view, TermId>::const_iterator it = _ids.find(term);
+	return (it != _ids.end()) ? it->second : NO_SUCH_TERM;
+}
+
+/**
+ * A method that returns the term of an id.
+ * @param id an id returned by intern.
+ * @return the term.
+ */
+const std::string& TermDictionary::getTerm(TermId id) const
+{
+	return _terms[id];
+}
+
+/**
+ * A method that returns the number of terms, the ids are 0 to size() - 1.
+ * @return the number of terms.
+ */
+size_t TermDictionary::size() const
+{
+	return _terms.size();
+}
+
+/**
+ * A method that writes the terms to a snapshot.
+ * @param snapshot the snapshot to write to.
+ */
+void TermDictionary::save(SnapshotWriter &snapshot) const
+{
+	snapshot.writeValue<uint64_t>(_terms.size());
+	for (const std::string &term : _terms)
+	{
+		snapshot.writeString(term);
+	}
+}
+
+/**
+ * A method that reads the terms of a snapshot, they must get the ids they had when the snapshot
+ * was written.
+ * @param snapshot the snapshot to read from.
+ * @return true iff the terms were read and got their ids.
+ */
+bool TermDictionary::load(SnapshotReader &snapshot)
+{
+	uint64_t numOfTerms;
+	if (!snapshot.readValue(numOfTerms))
+	{
+		return false;
+	}
+	std::string term;
+	for (uint64_t id = 0; id < numOfTerms; id++)
+	{
+		if (!snapshot.readString(term) || intern(term) != id)
+		{
+			return false;
+		}
+	}
+	return true;
+}
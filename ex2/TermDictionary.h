@@ -0,0 +1,87 @@
+// TermDictionary.h
+#ifndef TERM_DICTIONARY_H_
+#define TERM_DICTIONARY_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Snapshot.h"
+
+typedef uint32_t TermId;
+const TermId NO_SUCH_TERM = UINT32_MAX;
+
+/**
+ * A class that represents the dictionary of the terms(tags, lyrics words and instruments) of all
+ * the songs. Every distinct term is stored once and gets a 32 bit id, so the songs keep ids
+ * instead of copies of the terms.
+ * Terms may be interned by several threads at once, but not while other threads look them up.
+ */
+class TermDictionary
+{
+	public:
+		/**
+		 * A method that returns the dictionary of the program.
+		 * @return the single instance of the dictionary.
+		 */
+		static TermDictionary& getInstance();
+
+		TermDictionary(const TermDictionary&) = delete;
+		TermDictionary& operator=(const TermDictionary&) = delete;
+
+		/**
+		 * A method that returns the id of a term, the term is added in case it is new.
+		 * @param term the term.
+		 * @return the id of the term.
+		 */
+		TermId intern(std::string_view term);
+
+		/**
+		 * A method that returns the id of a term without adding it.
+		 * @param term the term.
+		 * @return the id of the term, or NO_SUCH_TERM in case it was never interned.
+		 */
+		TermId find(std::string_view term) const;
+
+		/**
+		 * A method that returns the term of an id.
+		 * @param id an id returned by intern.
+		 * @return the term.
+		 */
+		const std::string& getTerm(TermId id) const;
+
+		/**
+		 * A method that returns the number of terms, the ids are 0 to size() - 1.
+		 * @return the number of terms.
+		 */
+		size_t size() const;
+
+		/**
+		 * A method that writes the terms to a snapshot.
+		 * @param snapshot the snapshot to write to.
+		 */
+		void save(SnapshotWriter &snapshot) const;
+
+		/**
+		 * A method that reads the terms of a snapshot, they must get the ids they had when the
+		 * snapshot was written, so the dictionary should have no other terms.
+		 * @param snapshot the snapshot to read from.
+		 * @return true iff the terms were read and got their ids.
+		 */
+		bool load(SnapshotReader &snapshot);
+
+	private:
+		/**
+		 * The default ctor, creates an empty dictionary.
+		 */
+		TermDictionary();
+
+		std::deque<std::string> _terms; /**< the terms by their id, a deque so they never move */
+		std::unordered_map<std::string_view, TermId> _ids; /**< a map from every term(a view of
+															 its copy in _terms) to its id */
+		std::mutex _mutex; /**< a mutex that guards the adding of terms */
+};
+
+#endif // TERM_DICTIONARY_H_
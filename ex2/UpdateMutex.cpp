@@ -0,0 +1,65 @@
+/*
+ * ----------------------------------------------------------------------
+ * This file contains the implementation of the UpdateMutex class methods
+ * ----------------------------------------------------------------------
+ */
+#include "UpdateMutex.h"
+
+/**
+ * The default ctor, creates an unlocked mutex.
+ */
+UpdateMutex::UpdateMutex() : _numOfReaders(0), _numOfWaitingWriters(0), _isWriting(false)
+{
+}
+
+/**
+ * A method that locks the mutex for writing, it waits for the readers that have it.
+ */
+void UpdateMutex::lock()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_numOfWaitingWriters++;
+	_canWrite.wait(lock, [this]() { return !_isWriting && _numOfReaders == 0; });
+	_numOfWaitingWriters--;
+	_isWriting = true;
+}
+
+/**
+ * A method that unlocks the mutex after writing.
+ */
+void UpdateMutex::unlock()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isWriting = false;
+	}
+	// Another waiting writer goes first, the readers wait for it anyway.
+	_canWrite.notify_one();
+	_canRead.notify_all();
+}
+
+/**
+ * A method that locks the mutex for reading, it waits while a writer has or waits for it.
+ */
+void UpdateMutex::lock_shared()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_canRead.wait(lock, [this]() { return !_isWriting && _numOfWaitingWriters == 0; });
+	_numOfReaders++;
+}
+
+/**
+ * A method that unlocks the mutex after reading.
+ */
+void UpdateMutex::unlock_shared()
+{
+	bool isLastReader;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		isLastReader = (--_numOfReaders == 0);
+	}
+	if (isLastReader)
+	{
+		_canWrite.notify_one();
+	}
+}
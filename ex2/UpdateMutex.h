@@ -0,0 +1,54 @@
+// UpdateMutex.h
+#ifndef UPDATE_MUTEX_H_
+#define UPDATE_MUTEX_H_
+
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * A class that represents a readers-writer mutex that prefers the writer: once a writer waits, no
+ * new reader gets the mutex, so a steady load of readers does not starve the writer(unlike
+ * std::shared_mutex, which does not define the preference). It is locked by std::unique_lock for
+ * writing and by std::shared_lock for reading.
+ */
+class UpdateMutex
+{
+	public:
+		/**
+		 * The default ctor, creates an unlocked mutex.
+		 */
+		UpdateMutex();
+
+		UpdateMutex(const UpdateMutex&) = delete;
+		UpdateMutex& operator=(const UpdateMutex&) = delete;
+
+		/**
+		 * A method that locks the mutex for writing, it waits for the readers that have it.
+		 */
+		void lock();
+
+		/**
+		 * A method that unlocks the mutex after writing.
+		 */
+		void unlock();
+
+		/**
+		 * A method that locks the mutex for reading, it waits while a writer has or waits for it.
+		 */
+		void lock_shared();
+
+		/**
+		 * A method that unlocks the mutex after reading.
+		 */
+		void unlock_shared();
+
+	private:
+		std::mutex _mutex; /**< a mutex that guards the state */
+		std::condition_variable _canRead; /**< notified when the writer unlocks */
+		std::condition_variable _canWrite; /**< notified when the mutex may be free to write */
+		unsigned int _numOfReaders; /**< the number of readers that have the mutex */
+		unsigned int _numOfWaitingWriters; /**< the number of writers that wait for the mutex */
+		bool _isWriting; /**< true iff a writer has the mutex */
+};
+
+#endif // UPDATE_MUTEX_H_
@@ -3,21 +3,51 @@
  * This file contains the implementation of the Vocal class methods
  * ----------------------------------------------------------------
  */
+#include <algorithm>
 #include "Vocal.h"
 
 /**
 * The default ctor.
 * @param title the title of the song.
 * @param tagsValue the value of tags related to the song.
-* @param wordsOccurence contains mapping between words and the number of time it occures inn
-* the song
+* @param lyrics the ids of the lyrics words, in the lyrics order.
 * @param lyricsBy the writer of the song lyrics.
 */
-Vocal::Vocal(const std::string &title, const std::map<std::string, int> &tagsValue,
-			 const std::vector<std::string> &lyrics,
-			 const std::string &lyricsBy) : Song::Song(title, tagsValue), 
-			  _lyrics(lyrics), _lyricsBy(lyricsBy)
+Vocal::Vocal(std::string_view title, TagsValue tagsValue, SongTerms lyrics,
+			 std::string_view lyricsBy) : Song::Song(title, std::move(tagsValue)), 
+			  _wordsOccurence(lyrics.get_allocator()), _lyrics(std::move(lyrics)),
+			  _lyricsBy(lyricsBy, _lyrics.get_allocator())
 {
+	// The words are sorted in a buffer of the thread, so only the counts are kept by the song.
+	static thread_local std::vector<TermId> words;
+	words.assign(_lyrics.begin(), _lyrics.end());
+	std::sort(words.begin(), words.end());
+	size_t numOfDistinctWords = 0;
+	for (size_t i = 0; i < words.size(); i++)
+	{
+		numOfDistinctWords += (i == 0 || words[i] != words[i - 1]) ? 1 : 0;
+	}
+	_wordsOccurence.reserve(numOfDistinctWords);
+	for (std::vector<TermId>::const_iterator it = words.begin(); it != words.end(); ++it)
+	{
+		if (!_wordsOccurence.empty() && _wordsOccurence.back().first == *it)
+		{
+			_wordsOccurence.back().second++;
+		}
+		else
+		{
+			_wordsOccurence.push_back(std::pair<TermId, int>(*it, 1));
+		}
+	}
+}
+
+/**
+ * A method used to return the kind of the song.
+ * @return VOCAL.
+ */
+SongKind Vocal::getKind() const
+{
+	return VOCAL;
 }
 
 /**
@@ -25,10 +55,47 @@ Vocal::Vocal(const std::string &title, const std::map<std::string, int> &tagsVal
  * @return vector that contains the lyrics of the song. 
  */
 std::vector<std::string> Vocal::getLyrics() const
+{
+	std::vector<std::string> lyrics;
+	lyrics.reserve(_lyrics.size());
+	for (SongTerms::const_iterator it = _lyrics.begin(); it != _lyrics.end(); ++it)
+	{
+		lyrics.push_back(TermDictionary::getInstance().getTerm(*it));
+	}
+	return lyrics;
+}
+
+/**
+ * A method used to return the ids of the lyrics words.
+ * @return a vector of the ids, in the lyrics order.
+ */
+const SongTerms& Vocal::getLyricsTerms() const
 {
 	return _lyrics;
 }
 
+/**
+ * A method used to return the number of times every word occures in the lyrics.
+ * @return the words ids and their number of occurences, sorted by the id.
+ */
+const WordsOccurence& Vocal::getWordsOccurence() const
+{
+	return _wordsOccurence;
+}
+
+/**
+ * A method used to return the number of times a word occures in the lyrics.
+ * @param word the id of the word.
+ * @return the number of occurences of the word.
+ */
+int Vocal::wordOccurence(TermId word) const
+{
+	WordsOccurence::const_iterator it = std::lower_bound(_wordsOccurence.begin(),
+														 _wordsOccurence.end(),
+														 std::pair<TermId, int>(word, 0));
+	return ((it != _wordsOccurence.end()) && (it->first == word)) ? it->second : NO_SUCH_WORD;
+}
+
 /**
 * A method that is used to determine if an instrument used at the creation of the song.
 * @param instrument the instrument to check.
@@ -39,6 +106,25 @@ bool Vocal::isInstrumentUsed(const std::string&) const
 	return NO_INSTRUMENTS_USED;
 }
 
+/**
+* A method that returns the instruments used to create the song.
+* @return an empty set, no instruments are used in a vocal song.
+*/
+std::set<std::string> Vocal::getInstruments() const
+{
+	return std::set<std::string>();
+}
+
+/**
+* A method that returns the ids of the instruments used to create the song.
+* @return an empty vector, no instruments are used in a vocal song.
+*/
+const SongTerms& Vocal::getInstrumentsTerms() const
+{
+	static const SongTerms noInstruments;
+	return noInstruments;
+}
+
 /**
 * A method that is used to get the beats per minute of the song.
 * @return the bpm of the song.
@@ -54,5 +140,5 @@ int Vocal::getBpm() const
 */
 std::string Vocal::getCreator() const
 {
-	return "lyrics by: " + _lyricsBy;
+	return "lyrics by: " + std::string(_lyricsBy);
 }
@@ -15,12 +15,17 @@ class Vocal : Song
 		 * The default ctor.
 		 * @param title the title of the song.
 		 * @param tagsValue the value of tags related to the song.
-		 * @param lyrics the lyrics of the song.
-		 * the song
+		 * @param lyrics the ids of the lyrics words, in the lyrics order.
 		 * @param lyricsBy the writer of the song lyrics.
 		 */
-		Vocal(const std::string &title, const std::map<std::string, int> &tagsValue,
-			  const std::vector<std::string> &lyrics, const std::string &lyricsBy);
+		Vocal(std::string_view title, TagsValue tagsValue, SongTerms lyrics,
+			  std::string_view lyricsBy);
+
+		/**
+		 * A method used to return the kind of the song.
+		 * @return VOCAL.
+		 */
+		SongKind getKind() const;
 
 		/**
 		 * A method used to return the lyrics of the song.
@@ -28,6 +33,25 @@ class Vocal : Song
 		 */
 		std::vector<std::string> getLyrics() const;
 
+		/**
+		 * A method used to return the ids of the lyrics words.
+		 * @return a vector of the ids, in the lyrics order.
+		 */
+		const SongTerms& getLyricsTerms() const;
+
+		/**
+		 * A method used to return the number of times every word occures in the lyrics.
+		 * @return the words ids and their number of occurences, sorted by the id.
+		 */
+		const WordsOccurence& getWordsOccurence() const;
+
+		/**
+		 * A method used to return the number of times a word occures in the lyrics.
+		 * @param word the id of the word.
+		 * @return the number of occurences of the word.
+		 */
+		int wordOccurence(TermId word) const;
+
 		/**
 		 * A method that is used to determine if an instrument used at the creation of the song.
 		 * @param instrument the instrument to check.
@@ -35,6 +59,18 @@ class Vocal : Song
 		 */
 		bool isInstrumentUsed(const std::string&) const;
 
+		/**
+		 * A method that returns the instruments used to create the song.
+		 * @return an empty set, no instruments are used in a vocal song.
+		 */
+		std::set<std::string> getInstruments() const;
+
+		/**
+		 * A method that returns the ids of the instruments used to create the song.
+		 * @return an empty vector, no instruments are used in a vocal song.
+		 */
+		const SongTerms& getInstrumentsTerms() const;
+
 		/**
 		* A method that is used to get the beats per minute of the song.
 		* @return the bpm of the song.
@@ -48,10 +84,10 @@ class Vocal : Song
 		std::string getCreator() const;
 
 	private:
-		std::map<std::string, int> _wordsOccurence; /**< a map contains every word occur in the 
-													  lyrics and the number of times it occures. */
-		std::vector<std::string> _lyrics; /**< a vector contains the lyrics of the song */
-		std::string _lyricsBy; /**< a string contains the name of the one who wrote the song 
+		WordsOccurence _wordsOccurence; /**< every word occur in the lyrics and the number of times
+										  it occures, sorted by the word id */
+		SongTerms _lyrics; /**< a vector contains the ids of the lyrics words */
+		std::pmr::string _lyricsBy; /**< a string contains the name of the one who wrote the song 
 								 lyrics */
 };
 
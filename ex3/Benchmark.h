@@ -0,0 +1,219 @@
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+const unsigned int DEFAULT_BENCHMARK_WARMUPS = 2;
+const unsigned int DEFAULT_BENCHMARK_SAMPLES = 10;
+const double BENCHMARK_PERCENTILE = 0.95;
+const double GIGA = 1e9;
+
+/**
+ * The command line options of a benchmark:
+ * --sizes n1,n2,...  the sizes of the square matrices.
+ * --samples n        the number of measured runs of every case.
+ * --warmup n         the number of runs before the measured ones.
+ * --format csv|json  the format of the results.
+ * --output file      the file to write the results to, the standard output by default.
+ */
+struct BenchmarkOptions
+{
+	std::vector<unsigned int> sizes; /**< The sizes of the square matrices */
+	unsigned int samples; /**< The number of measured runs of every case */
+	unsigned int warmups; /**< The number of runs before the measured ones */
+	bool json; /**< True for json results, false for csv */
+	std::string output; /**< The results file, empty for the standard output */
+};
+
+/**
+ * The result of a single benchmark case.
+ */
+struct BenchmarkResult
+{
+	std::string library; /**< The measured matrix class */
+	std::string operation; /**< The measured operation */
+	std::string type; /**< The type of the cells */
+	std::string mode; /**< "sequential" or "parallel" */
+	unsigned int size; /**< The size of the square matrices */
+	unsigned int samples; /**< The number of measured runs */
+	double median; /**< The median run time in seconds */
+	double p95; /**< The 95th percentile run time in seconds */
+	double gflops; /**< Billions of floating point operations per second, by the median */
+	double gbps; /**< Gigabytes moved per second, by the median */
+};
+
+/**
+ * A function that parses the benchmark command line.
+ * @param argc the number of arguments.
+ * @param argv the arguments.
+ * @param defaultSizes the sizes to use when --sizes is not given.
+ * @return the options.
+ * @throws std::invalid_argument in case of an unknown or malformed option.
+ */
+inline BenchmarkOptions parseBenchmarkOptions(int argc, char *argv[],
+											  const std::vector<unsigned int> &defaultSizes)
+{
+	BenchmarkOptions options;
+	options.sizes = defaultSizes;
+	options.samples = DEFAULT_BENCHMARK_SAMPLES;
+	options.warmups = DEFAULT_BENCHMARK_WARMUPS;
+	options.json = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string option = argv[i];
+		if (i + 1 == argc)
+		{
+			throw std::invalid_argument("Missing the value of " + option);
+		}
+		std::string value = argv[++i];
+
+		if (option == "--sizes")
+		{
+			options.sizes.clear();
+			std::istringstream sizes(value);
+			std::string size;
+			while (std::getline(sizes, size, ','))
+			{
+				options.sizes.push_back(std::stoul(size));
+			}
+		}
+		else if (option == "--samples")
+		{
+			options.samples = std::max(1ul, std::stoul(value));
+		}
+		else if (option == "--warmup")
+		{
+			options.warmups = std::stoul(value);
+		}
+		else if (option == "--format" && (value == "csv" || value == "json"))
+		{
+			options.json = (value == "json");
+		}
+		else if (option == "--output")
+		{
+			options.output = value;
+		}
+		else
+		{
+			throw std::invalid_argument("Unknown option " + option + " " + value);
+		}
+	}
+	return options;
+}
+
+/**
+ * A function that measures an operation, the operation is run options.warmups times and then
+ * options.samples times measured by a monotonic clock.
+ * @param options the benchmark options.
+ * @param operation the operation to run.
+ * @param flops the number of floating point(or integer) operations of a single run.
+ * @param bytes the number of bytes a single run reads and writes.
+ * @param result the result to fill the times and rates of, the other fields are kept.
+ */
+template<typename Operation>
+void measure(const BenchmarkOptions &options, const Operation &operation, double flops,
+			 double bytes, BenchmarkResult &result)
+{
+	for (unsigned int i = 0; i < options.warmups; i++)
+	{
+		operation();
+	}
+
+	std::vector<double> times;
+	for (unsigned int i = 0; i < options.samples; i++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		operation();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		times.push_back(elapsed.count());
+	}
+	std::sort(times.begin(), times.end());
+
+	unsigned int middle = times.size() / 2;
+	result.samples = times.size();
+	result.median = (times.size() % 2 == 1) ? times[middle] :
+					(times[middle - 1] + times[middle]) / 2;
+	// The nearest rank percentile.
+	result.p95 = times[static_cast<unsigned int>(std::ceil(BENCHMARK_PERCENTILE * times.size())) -
+					   1];
+	result.gflops = (result.median > 0) ? flops / result.median / GIGA : 0;
+	result.gbps = (result.median > 0) ? bytes / result.median / GIGA : 0;
+}
+
+/**
+ * A function that writes the results as csv, a header line and a line for every result.
+ * @param output the stream to write to.
+ * @param results the results.
+ */
+inline void writeCsv(std::ostream &output, const std::vector<BenchmarkResult> &results)
+{
+	output << "library,operation,type,mode,size,samples,median_sec,p95_sec,gflops,gbps"
+		   << std::endl;
+	for (const BenchmarkResult &result : results)
+	{
+		output << result.library << ',' << result.operation << ',' << result.type << ','
+			   << result.mode << ',' << result.size << ',' << result.samples << ','
+			   << result.median << ',' << result.p95 << ',' << result.gflops << ','
+			   << result.gbps << std::endl;
+	}
+}
+
+/**
+ * A function that writes the results as a json object, with the number of hardware threads and
+ * an array of the results.
+ * @param output the stream to write to.
+ * @param results the results.
+ */
+inline void writeJson(std::ostream &output, const std::vector<BenchmarkResult> &results)
+{
+	output << "{\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+		   << ",\n  \"results\": [";
+	for (unsigned int i = 0; i < results.size(); i++)
+	{
+		const BenchmarkResult &result = results[i];
+		output << (i == 0 ? "\n" : ",\n")
+			   << "    {\"library\": \"" << result.library << "\", \"operation\": \""
+			   << result.operation << "\", \"type\": \"" << result.type << "\", \"mode\": \""
+			   << result.mode << "\", \"size\": " << result.size << ", \"samples\": "
+			   << result.samples << ", \"median_sec\": " << result.median << ", \"p95_sec\": "
+			   << result.p95 << ", \"gflops\": " << result.gflops << ", \"gbps\": "
+			   << result.gbps << "}";
+	}
+	output << "\n  ]\n}" << std::endl;
+}
+
+/**
+ * A function that writes the results in the format and to the file given by the options.
+ * @param options the benchmark options.
+ * @param results the results.
+ * @throws std::runtime_error in case the output file cannot be opened.
+ */
+inline void writeResults(const BenchmarkOptions &options,
+						 const std::vector<BenchmarkResult> &results)
+{
+	std::ofstream file;
+	if (!options.output.empty())
+	{
+		file.open(options.output);
+		if (!file)
+		{
+			throw std::runtime_error("Cannot open " + options.output);
+		}
+	}
+	std::ostream &output = options.output.empty() ? std::cout : file;
+	output.precision(6);
+	options.json ? writeJson(output, results) : writeCsv(output, results);
+}
+
+#endif // BENCHMARK_H_
@@ -4,29 +4,60 @@
 #include <iostream>
 #include <algorithm>
 #include <exception>
+#include <functional>
 #include <vector>
 #include <iterator>
-#include <thread>
+#include <type_traits>
 #include "Complex.h"
 #include "MatricesDimensionsError.h"
 #include "NotSquareMatrixTrace.h"
+#include "MatrixExpression.hpp"
+#include "ThreadPool.h"
 
 const int ZERO_ELEMENT_CTOR_INPUT = 0;
 const char MATRIX_ROW_CELLS_SEPERATOR = '\t';
 const int DEFAULT_CTOR_ROWS = 1;
 const int DEFAULT_CTOR_COLS = 1;
+const unsigned int GEMM_MC = 64;
+const unsigned int GEMM_KC = 256;
+const unsigned int GEMM_NC = 512;
+const unsigned int GEMM_MR = 4;
+const unsigned int GEMM_NR = 4;
+const unsigned int TRANSPOSE_BLOCK = 32;
+
+/**
+ * A trait that tells whether the multipication of matrices of T should use the blocked kernel.
+ * True for the arithmetic types and for Complex.
+ */
+template<typename T>
+struct IsBlockedMulElement : std::is_arithmetic<T>
+{
+};
+
+template<>
+struct IsBlockedMulElement<Complex> : std::true_type
+{
+};
 
 /**
  * A template class represents a Generic matrix implementation.
+ * The inner kernels access the cells without bounds checks, the public operator() checks its
+ * indices unless the MATRIX_UNCHECKED_ACCESS macro is defined.
+ * The +, - , scalar * and trans operations return lazy expressions(see MatrixExpression.hpp) that
+ * are computed in a single pass when assigned to a matrix.
  */
 template<typename T>
-class Matrix
+class Matrix : public MatrixExpression<Matrix<T>, T>
 {	
 	private:
-		typedef void (Matrix<T>::*parallelCalcMethod) (const Matrix<T>&, Matrix<T>&, unsigned int) 
-													   const; /**<A typedef defines a pointer to 
-																function that used for 
-																parallel calculation. */
+		friend class MatrixExpression<Matrix<T>, T>;
+		friend struct ExpressionRow<Matrix<T>, T>;
+
+		typedef void (Matrix<T>::*parallelCalcMethod) (const Matrix<T>&, Matrix<T>&, unsigned int,
+													   unsigned int) const; /**<A typedef defines a 
+																			 pointer to function 
+																			 that used for parallel 
+																			 calculation. */
 		std::vector<T> _matrix; /**< A vector contains the matrix data*/
 		unsigned int _numOfRows; /**< The number of rows */
 		unsigned int _numOfCols; /**< The number of cols */
@@ -34,66 +65,529 @@ class Matrix
 								   * computation or not */
 
 		/**
-		 * A method that is used to calc the sum of the calling object row with a given other row
-		 * and save it to the same row at sol.
-		 * @param other the matrix to sum the row with.
-		 * @param sol the matrix to save the solution at.
-		 * @param row the row to sum.
+		 * A method that returns a pointer to the first cell of a given row, the row is not
+		 * checked so it is used only by the inner kernels.
+		 * @param row the row to point to.
+		 * @return a pointer to matrix[row,0].
 		 */
-		void _calcRowSum(const Matrix<T> &other, Matrix<T> &sol, unsigned int row) const noexcept
+		T* _rowData(unsigned int row) noexcept
 		{
-			for (unsigned int i = 0; i < _numOfCols; i++)
+			return _matrix.data() + (row * _numOfCols);
+		}
+
+		/**
+		 * A method that returns a pointer to the first cell of a given row, the row is not
+		 * checked so it is used only by the inner kernels.
+		 * @param row the row to point to.
+		 * @return a const pointer to matrix[row,0].
+		 */
+		const T* _rowData(unsigned int row) const noexcept
+		{
+			return _matrix.data() + (row * _numOfCols);
+		}
+
+		/**
+		 * A method that returns a cell without checking the indices.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return a reference to matrix[row,col].
+		 */
+		T& _cell(unsigned int row, unsigned int col) noexcept
+		{
+			return _matrix[(row * _numOfCols) + col];
+		}
+
+		/**
+		 * A method that returns a cell without checking the indices.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return a const reference to matrix[row,col].
+		 */
+		const T& _cell(unsigned int row, unsigned int col) const noexcept
+		{
+			return _matrix[(row * _numOfCols) + col];
+		}
+
+		/**
+		 * A method that copies a row of the matrix, used when the matrix is the operand of an
+		 * expression.
+		 * @param row the row to copy.
+		 * @param dest the array to copy the row cells to.
+		 */
+		void _evalRow(unsigned int row, T *dest) const
+		{
+			std::copy(_rowData(row), _rowData(row) + _numOfCols, dest);
+		}
+
+		/**
+		 * A method that returns whether the matrix is a given matrix, used when the matrix is the
+		 * operand of an expression.
+		 * @param matrix the matrix.
+		 * @return true iff the calling object is the given matrix.
+		 */
+		bool _refersTo(const Matrix<T> &matrix) const noexcept
+		{
+			return this == &matrix;
+		}
+
+		/**
+		 * A method that checks that the given cells can fill a matrix of the given dimensions.
+		 * @param rows the number of rows.
+		 * @param cols the number of cols.
+		 * @param cells the cells of the matrix.
+		 * @throws std::invalid_argument.
+		 */
+		static void _checkCells(unsigned int rows, unsigned int cols, const std::vector<T> &cells)
+		{
+			// Case only one of the row / cols equal to 0
+			if ((rows == 0 || cols == 0) && (rows != cols))
 			{
-				sol(row, i) = (*this)(row, i) + other(row, i);
+				throw std::invalid_argument("Cannot create matrix with row or "
+											 "col > 0 and the other parameter > 0");
+			}
+			
+			// Case the vector given is not in the given size.
+			if (cells.size() != (rows * cols))
+			{
+				throw std::invalid_argument("Rows or cols didn't match the size of "
+											"the given container");
+			}
+		}
+
+		/**
+		 * A method that updates every cell of the matrix in place with the matching cell of an
+		 * element-wise expression, cell = op(cell, other[row,col]).
+		 * The rows of a matrix operand are updated by the given kernel, the other expressions are
+		 * computed a cell at a time so no row buffer is needed, which is safe even when the
+		 * expression reads the calling object since every cell depends only on the same cell of
+		 * the operands.
+		 * @param other the expression, of the same dimensions as the calling object.
+		 * @param kernel the VectorKernels method that computes op on a row.
+		 * @param op the operation.
+		 */
+		template<typename E, typename Kernel, typename Op>
+		void _updateCells(const E &other, Kernel kernel, Op op, std::true_type)
+		{
+			auto updateRows = [&](unsigned int first, unsigned int last)
+			{
+				for (unsigned int i = first; i < last; i++)
+				{
+					T *row = _rowData(i);
+					const T *cells = ExpressionRow<E, T>::cells(other, i);
+					if (cells != nullptr)
+					{
+						kernel(row, cells, row, _numOfCols);
+						continue;
+					}
+					for (unsigned int j = 0; j < _numOfCols; j++)
+					{
+						row[j] = op(row[j], other.cell(i, j));
+					}
+				}
+			};
+
+			// Case the matrix is in "parallel mode".
+			if (_isParallel)
+			{
+				ThreadPool::getInstance().parallelFor(0, _numOfRows, updateRows);
+			}
+			// Case the matrix is in "sequential mode"
+			else
+			{
+				updateRows(0, _numOfRows);
+			}
+		}
+
+		/**
+		 * Like the element-wise _updateCells for expressions that are not element-wise(a
+		 * transpose), which may read cells that were already updated, so the expression is
+		 * evaluated to a new matrix first.
+		 * @param other the expression, of the same dimensions as the calling object.
+		 * @param kernel the VectorKernels method that computes op on a row.
+		 * @param op the operation.
+		 * @throws std::bad_alloc
+		 */
+		template<typename E, typename Kernel, typename Op>
+		void _updateCells(const E &other, Kernel kernel, Op op, std::false_type)
+		{
+			_updateCells(Matrix<T>(other), kernel, op, std::true_type());
+		}
+
+		/**
+		 * A method that computes the rows of an expression into the matrix, which has the
+		 * dimensions of the expression.
+		 * @param expression the expression to evaluate.
+		 * @throws std::system_error
+		 */
+		template<typename E>
+		void _evaluate(const E &expression)
+		{
+			auto evalRows = [&](unsigned int first, unsigned int last)
+			{
+				for (unsigned int i = first; i < last; i++)
+				{
+					expression.evalRow(i, _rowData(i));
+				}
+			};
+
+			// Case the matrix is in "parallel mode".
+			if (_isParallel)
+			{
+				ThreadPool::getInstance().parallelFor(0, _numOfRows, evalRows);
+			}
+			// Case the matrix is in "sequential mode"
+			else
+			{
+				evalRows(0, _numOfRows);
 			}
 		}
 
 		/**
-		 * A method that is used to calc the multipication of the calling object row with 
-		 * a given other column and save it to the sol.
-		 * done by the multipication iteration method.
-		 * @param other the matrix to multiply with its column.
+		 * Like _evaluate for the transpose of a matrix, which is copied by _transposeBlock
+		 * instead of a row at a time, since a row of the transpose is a column of the source.
+		 * The other transposed expressions are evaluated a row at a time.
+		 * @param expression the transpose to evaluate.
+		 * @throws std::system_error
+		 */
+		template<typename E>
+		void _evaluate(const MatrixTranspose<E, T> &expression)
+		{
+			const T *source = (_numOfRows == 0) ? nullptr :
+							  ExpressionRow<E, T>::cells(expression.operand(), 0);
+			if (source == nullptr)
+			{
+				_evaluate<MatrixTranspose<E, T> >(expression);
+				return;
+			}
+
+			// The source has _numOfCols rows and _numOfRows cols.
+			auto transposeCols = [&](unsigned int first, unsigned int last)
+			{
+				_transposeBlock(source, _numOfRows, _matrix.data(), _numOfCols, 0, _numOfCols,
+								first, last);
+			};
+
+			// Case the matrix is in "parallel mode".
+			if (_isParallel)
+			{
+				ThreadPool::getInstance().parallelFor(0, _numOfRows, transposeCols);
+			}
+			// Case the matrix is in "sequential mode"
+			else
+			{
+				transposeCols(0, _numOfRows);
+			}
+		}
+
+		/**
+		 * A method that writes the transpose of a block of a row-major matrix to the matching
+		 * block of another one, dest[col,row] = source[row,col], conjugated for Complex cells.
+		 * The block is split in halves along its longer side until it is at most
+		 * TRANSPOSE_BLOCK x TRANSPOSE_BLOCK, so both the reads and the strided writes stay in
+		 * the cache whatever its size is(a cache-oblivious transpose).
+		 * @param source the first cell of the source matrix.
+		 * @param sourceCols the number of cols of the source matrix.
+		 * @param dest the first cell of the destination matrix.
+		 * @param destCols the number of cols of the destination matrix.
+		 * @param firstRow the first source row of the block.
+		 * @param lastRow the past the end source row of the block.
+		 * @param firstCol the first source col of the block.
+		 * @param lastCol the past the end source col of the block.
+		 */
+		static void _transposeBlock(const T *source, unsigned int sourceCols, T *dest,
+									unsigned int destCols, unsigned int firstRow,
+									unsigned int lastRow, unsigned int firstCol,
+									unsigned int lastCol)
+		{
+			unsigned int numOfRows = lastRow - firstRow;
+			unsigned int numOfCols = lastCol - firstCol;
+			if (numOfRows > TRANSPOSE_BLOCK && numOfRows >= numOfCols)
+			{
+				unsigned int middle = firstRow + (numOfRows / 2);
+				_transposeBlock(source, sourceCols, dest, destCols, firstRow, middle, firstCol,
+								lastCol);
+				_transposeBlock(source, sourceCols, dest, destCols, middle, lastRow, firstCol,
+								lastCol);
+				return;
+			}
+			if (numOfCols > TRANSPOSE_BLOCK)
+			{
+				unsigned int middle = firstCol + (numOfCols / 2);
+				_transposeBlock(source, sourceCols, dest, destCols, firstRow, lastRow, firstCol,
+								middle);
+				_transposeBlock(source, sourceCols, dest, destCols, firstRow, lastRow, middle,
+								lastCol);
+				return;
+			}
+
+			for (unsigned int i = firstRow; i < lastRow; i++)
+			{
+				const T *row = source + (i * sourceCols);
+				for (unsigned int j = firstCol; j < lastCol; j++)
+				{
+					dest[(j * destCols) + i] = transposedCell(row[j]);
+				}
+			}
+		}
+
+		/**
+		 * A method that transposes the TRANSPOSE_BLOCK rows of a square matrix that start at
+		 * the given row in place, the diagonal tile is transposed and every tile right of it is
+		 * swapped with the matching tile below the diagonal.
+		 * @param firstRow the first row of the tiles, a multiple of TRANSPOSE_BLOCK.
+		 */
+		void _transposeTilesInPlace(unsigned int firstRow)
+		{
+			unsigned int lastRow = std::min(firstRow + TRANSPOSE_BLOCK, _numOfRows);
+
+			// The diagonal tile
+			for (unsigned int i = firstRow; i < lastRow; i++)
+			{
+				_cell(i, i) = transposedCell(_cell(i, i));
+				for (unsigned int j = i + 1; j < lastRow; j++)
+				{
+					T upper = _cell(i, j);
+					_cell(i, j) = transposedCell(_cell(j, i));
+					_cell(j, i) = transposedCell(upper);
+				}
+			}
+
+			for (unsigned int firstCol = lastRow; firstCol < _numOfCols; 
+				 firstCol += TRANSPOSE_BLOCK)
+			{
+				unsigned int lastCol = std::min(firstCol + TRANSPOSE_BLOCK, _numOfCols);
+				for (unsigned int i = firstRow; i < lastRow; i++)
+				{
+					for (unsigned int j = firstCol; j < lastCol; j++)
+					{
+						T upper = _cell(i, j);
+						_cell(i, j) = transposedCell(_cell(j, i));
+						_cell(j, i) = transposedCell(upper);
+					}
+				}
+			}
+		}
+
+		/**
+		 * A method that is used to calc the multipication of the calling object rows with the
+		 * given other matrix and save it to the same rows at sol.
+		 * Uses the blocked kernel when T is an arithmetic type(see IsBlockedMulElement).
+		 * @param other the matrix to multiply with.
+		 * @param sol the matrix to save the solution at, its rows should contain T(0).
+		 * @param firstRow the first row of the solution.
+		 * @param lastRow the past the end row of the solution.
+		 * @throws std::bad_alloc
+		 */
+		void _calcRowsMul(const Matrix<T> &other, Matrix<T> &sol, unsigned int firstRow, 
+						  unsigned int lastRow) const
+		{
+			_calcRowsMul(other, sol, firstRow, lastRow, IsBlockedMulElement<T>());
+		}
+
+		/**
+		 * The iteration method multipication, used for element types that are not arithmetic.
+		 * @param other the matrix to multiply with.
 		 * @param sol the matrix to save the solution at.
-		 * @param row the row of the solution.
+		 * @param firstRow the first row of the solution.
+		 * @param lastRow the past the end row of the solution.
 		 */
-		void _calcRowMul(const Matrix<T> &other, Matrix<T> &sol, unsigned int row) const noexcept
+		void _calcRowsMul(const Matrix<T> &other, Matrix<T> &sol, unsigned int firstRow, 
+						  unsigned int lastRow, std::false_type) const noexcept
 		{
+			/* ResultMatrix[i,j] is the sum from 0 to k-1 of right-handed matrix[i,k] * left-handed
+			 * matrix[k,j] */
 			T tempSum(ZERO_ELEMENT_CTOR_INPUT);
-			for (unsigned int i = 0; i < sol._numOfCols; i++)
+			for (unsigned int row = firstRow; row < lastRow; row++)
 			{
-				for (unsigned int j = 0; j < other._numOfCols; j++)
+				const T *left = _rowData(row);
+				for (unsigned int i = 0; i < sol._numOfCols; i++)
 				{
-					tempSum += ((*this)(row, j) * other(j, i));
+					for (unsigned int j = 0; j < _numOfCols; j++)
+					{
+						tempSum += (left[j] * other._cell(j, i));
+					}
+					sol._cell(row, i) = tempSum;
+					tempSum = T(ZERO_ELEMENT_CTOR_INPUT);
 				}
-				sol(row, i) = tempSum;
-				tempSum = T(ZERO_ELEMENT_CTOR_INPUT);
 			}
 		}
 
 		/**
-		 * A method used to calculate parallel computations.
-		 * @param other the right hand matrix of the operation.
-		 * @param resMatrix the matrix to fill the row at.
-		 * @param calcRow a pointer to a function used to calculate the computation
-		 * given by the typedef parallelCalcMethod.
+		 * The blocked multipication, the right hand matrix is packed panel by panel into
+		 * GEMM_KC x GEMM_NC blocks stored as GEMM_NR wide column slivers, and every GEMM_MR x
+		 * GEMM_NR tile of the solution is accumulated in registers.
+		 * Each cell still sums its products in increasing k order starting from T(0), so the
+		 * result is identical to the iteration method.
+		 * @param other the matrix to multiply with.
+		 * @param sol the matrix to save the solution at, its rows should contain T(0).
+		 * @param firstRow the first row of the solution.
+		 * @param lastRow the past the end row of the solution.
 		 * @throws std::bad_alloc
 		 */
-		void _calculateParallel(const Matrix<T> &other, 
-							    Matrix<T> &resMatrix, parallelCalcMethod calcRow) const
+		void _calcRowsMul(const Matrix<T> &other, Matrix<T> &sol, unsigned int firstRow, 
+						  unsigned int lastRow, std::true_type) const
+		{
+			const unsigned int n = other._numOfCols;
+			const unsigned int k = _numOfCols;
+			std::vector<T> packed(std::min(GEMM_KC, k) * 
+								  (((std::min(GEMM_NC, n) + GEMM_NR - 1) / GEMM_NR) * GEMM_NR));
+
+			for (unsigned int jc = 0; jc < n; jc += GEMM_NC)
+			{
+				unsigned int nc = std::min(GEMM_NC, n - jc);
+				for (unsigned int pc = 0; pc < k; pc += GEMM_KC)
+				{
+					unsigned int kc = std::min(GEMM_KC, k - pc);
+					other._packPanel(packed.data(), pc, kc, jc, nc);
+
+					for (unsigned int ic = firstRow; ic < lastRow; ic += GEMM_MC)
+					{
+						unsigned int mc = std::min(GEMM_MC, lastRow - ic);
+						for (unsigned int jr = 0; jr < nc; jr += GEMM_NR)
+						{
+							const T *sliver = packed.data() + (jr * kc);
+							unsigned int nr = std::min(GEMM_NR, nc - jr);
+							for (unsigned int ir = 0; ir < mc; ir += GEMM_MR)
+							{
+								unsigned int mr = std::min(GEMM_MR, mc - ir);
+								const T *a = _rowData(ic + ir) + pc;
+								T *c = sol._rowData(ic + ir) + jc + jr;
+								if (mr == GEMM_MR && nr == GEMM_NR)
+								{
+									_mulTile(a, k, sliver, kc, c, n);
+								}
+								else
+								{
+									_mulEdgeTile(a, k, sliver, kc, c, n, mr, nr);
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * A method that copies the block [firstRow, firstRow + numOfRows) x
+		 * [firstCol, firstCol + numOfCols) of the calling object into GEMM_NR wide column
+		 * slivers, every sliver is stored row after row and its missing columns are T(0).
+		 * @param dest the buffer to pack to.
+		 * @param firstRow the first row of the block.
+		 * @param numOfRows the number of rows of the block.
+		 * @param firstCol the first column of the block.
+		 * @param numOfCols the number of columns of the block.
+		 */
+		void _packPanel(T *dest, unsigned int firstRow, unsigned int numOfRows, 
+						unsigned int firstCol, unsigned int numOfCols) const noexcept
+		{
+			for (unsigned int jr = 0; jr < numOfCols; jr += GEMM_NR)
+			{
+				unsigned int nr = std::min(GEMM_NR, numOfCols - jr);
+				for (unsigned int p = 0; p < numOfRows; p++)
+				{
+					const T *src = _rowData(firstRow + p) + firstCol + jr;
+					unsigned int j = 0;
+					for (; j < nr; j++)
+					{
+						*dest++ = src[j];
+					}
+					for (; j < GEMM_NR; j++)
+					{
+						*dest++ = T(ZERO_ELEMENT_CTOR_INPUT);
+					}
+				}
+			}
+		}
+
+		/**
+		 * A method that adds the product of a GEMM_MR x kc block of the left hand matrix with a
+		 * packed sliver to a full GEMM_MR x GEMM_NR tile of the solution.
+		 * @param a the first cell of the left hand block.
+		 * @param lda the distance between two rows of the left hand block.
+		 * @param sliver the packed sliver of the right hand matrix.
+		 * @param kc the shared dimension of the block and the sliver.
+		 * @param c the first cell of the tile.
+		 * @param ldc the distance between two rows of the tile.
+		 */
+		static void _mulTile(const T *a, unsigned int lda, const T *sliver, unsigned int kc, 
+							 T *c, unsigned int ldc) noexcept
 		{
-				std::vector<std::thread> threads;
-				for (unsigned int i = 0; i < _numOfRows; i++)
+			T acc[GEMM_MR][GEMM_NR];
+			for (unsigned int r = 0; r < GEMM_MR; r++)
+			{
+				for (unsigned int j = 0; j < GEMM_NR; j++)
+				{
+					acc[r][j] = c[(r * ldc) + j];
+				}
+			}
+			for (unsigned int p = 0; p < kc; p++)
+			{
+				const T *b = sliver + (p * GEMM_NR);
+				for (unsigned int r = 0; r < GEMM_MR; r++)
+				{
+					const T aValue = a[(r * lda) + p];
+					for (unsigned int j = 0; j < GEMM_NR; j++)
+					{
+						acc[r][j] += aValue * b[j];
+					}
+				}
+			}
+			for (unsigned int r = 0; r < GEMM_MR; r++)
+			{
+				for (unsigned int j = 0; j < GEMM_NR; j++)
 				{
-					threads.push_back(std::thread(calcRow, this, other, std::ref(resMatrix), i));
+					c[(r * ldc) + j] = acc[r][j];
 				}
+			}
+		}
 
-				// Join the threads after the loop so all the threads will run parallel and not
-				// sequential.
-				for (std::vector<std::thread>::iterator it = threads.begin(); 
-					 it != threads.end(); it++)
+		/**
+		 * A method like _mulTile for the tiles at the bottom and right edges of the solution.
+		 * @param a the first cell of the left hand block.
+		 * @param lda the distance between two rows of the left hand block.
+		 * @param sliver the packed sliver of the right hand matrix.
+		 * @param kc the shared dimension of the block and the sliver.
+		 * @param c the first cell of the tile.
+		 * @param ldc the distance between two rows of the tile.
+		 * @param mr the number of rows of the tile.
+		 * @param nr the number of columns of the tile.
+		 */
+		static void _mulEdgeTile(const T *a, unsigned int lda, const T *sliver, unsigned int kc,
+								 T *c, unsigned int ldc, unsigned int mr, 
+								 unsigned int nr) noexcept
+		{
+			for (unsigned int r = 0; r < mr; r++)
+			{
+				for (unsigned int j = 0; j < nr; j++)
 				{
-					it->join();
-				}	
+					T acc = c[(r * ldc) + j];
+					for (unsigned int p = 0; p < kc; p++)
+					{
+						acc += a[(r * lda) + p] * sliver[(p * GEMM_NR) + j];
+					}
+					c[(r * ldc) + j] = acc;
+				}
+			}
+		}
+
+		/**
+		 * A method used to calculate parallel computations.
+		 * The rows are split into blocks that are executed by the process-wide thread pool.
+		 * @param other the right hand matrix of the operation.
+		 * @param resMatrix the matrix to fill the rows at.
+		 * @param calcRows a pointer to a function used to calculate the computation
+		 * given by the typedef parallelCalcMethod.
+		 * @throws std::bad_alloc
+		 * @throws std::system_error
+		 */
+		void _calculateParallel(const Matrix<T> &other, 
+							    Matrix<T> &resMatrix, parallelCalcMethod calcRows) const
+		{
+			ThreadPool::getInstance().parallelFor(0, _numOfRows, 
+												  [&](unsigned int first, unsigned int last)
+			{
+				(this->*calcRows)(other, resMatrix, first, last);
+			});
 		}
 
 	public:
@@ -165,22 +659,25 @@ class Matrix
 		Matrix(unsigned int rows, unsigned int cols, const std::vector<T>& cells)
 			   : _numOfRows(rows), _numOfCols(cols)
 		{
-			// Case only one of the row / cols equal to 0
-			if ((rows == 0 || cols == 0) && (rows != cols))
-			{
-				throw std::invalid_argument("Cannot create matrix with row or "
-											 "col > 0 and the other parameter > 0");
-			}
-			
-			// Case the vector given is not in the given size.
-			if (cells.size() != (rows * cols))
-			{
-				throw std::invalid_argument("Rows or cols didn't match the size of "
-											"the given container");
-			}
+			_checkCells(rows, cols, cells);
 			_matrix = cells;
 		}
 
+		/**
+		 * Like the container ctor, but takes the given vector as the matrix data instead of
+		 * copying it.
+		 * @param rows the number of rows.
+		 * @param cols the number of cols.
+		 * @param cells the vector to take, it is left empty.
+		 * @throws std::invalid_argument.
+		 */
+		Matrix(unsigned int rows, unsigned int cols, std::vector<T>&& cells)
+			   : _numOfRows(rows), _numOfCols(cols)
+		{
+			_checkCells(rows, cols, cells);
+			_matrix = std::move(cells);
+		}
+
 		/**
 		 * The copy ctor used to create an independant copy of a given matrix.
 		 * @param other the matrix to copy.
@@ -202,6 +699,23 @@ class Matrix
 			other._numOfCols = 0;
 		}
 
+		/**
+		 * A ctor used to evaluate a lazy expression into a new matrix. The vector zeroes its cells
+		 * when it is allocated, then the rows are computed over them in a single pass(over the
+		 * thread pool in "parallel mode") by the VectorKernels, the transpose of a matrix is
+		 * computed by blocks.
+		 * @param expression the expression to evaluate.
+		 * @throws std::bad_alloc.
+		 * @throws std::system_error
+		 */
+		template<typename E>
+		Matrix(const MatrixExpression<E, T> &expression) : 
+			   _matrix(expression.rows() * expression.cols()), _numOfRows(expression.rows()),
+			   _numOfCols(expression.cols())
+		{
+			_evaluate(static_cast<const E&>(expression));
+		}
+
 		/**
 		 * The default destructor.
 		 */
@@ -210,109 +724,186 @@ class Matrix
 		}
 			
 		/**
-		 * A method that overload the = operator.
+		 * A method that overload the = operator, the cells are copied into the existing buffer
+		 * when it is large enough.
 		 * @param other the matrix(from the same type) to be assigned with.
 		 * @return a reference to the calling object (assigned with the other matrix).
+		 * @throws std::bad_alloc
+		 */
+		Matrix<T>& operator=(const Matrix<T> &other)
+		{
+			_matrix = other._matrix;
+			_numOfRows = other._numOfRows;
+			_numOfCols = other._numOfCols;
+			return *this;
+		}
+
+		/**
+		 * A method that overload the = operator for temporaries, takes the other matrix data.
+		 * @param other the matrix(from the same type) to be moved from.
+		 * @return a reference to the calling object (assigned with the other matrix).
 		 */
-		Matrix<T>& operator=(Matrix<T> other) noexcept
+		Matrix<T>& operator=(Matrix<T> &&other) noexcept
 		{
 			swap(*this, other);
 			return *this;
 		}
 
 		/**
-		 * A method that overload the () operator.
-		 * @param row the row of the cell.
-		 * @param col the column of the cell.
-		 * @return matrix[i,j] which reference to the matrix.
-		 * @throws std::out_of_range exception.
+		 * A method that overload the = operator for a lazy expression, the rows are computed into
+		 * the existing buffer(like the expression ctor) when it is large enough. An expression
+		 * that reads the calling object is evaluated to a new matrix first, since its rows could
+		 * be overwritten before they are read.
+		 * @param expression the expression to be assigned with.
+		 * @return a reference to the calling object (assigned with the expression).
+		 * @throws std::bad_alloc
+		 * @throws std::system_error
 		 */
-		T& operator()(unsigned int row, unsigned int col)
+		template<typename E>
+		Matrix<T>& operator=(const MatrixExpression<E, T> &expression)
 		{
-			try
-			{
-				return _matrix.at((row * _numOfCols) + col);	
-			}
-			catch (std::out_of_range&)
+			if (expression.refersTo(*this))
 			{
-				throw std::out_of_range("Matrix indices are out of range");
+				return *this = Matrix<T>(expression);
 			}
+			_matrix.resize(expression.rows() * expression.cols());
+			_numOfRows = expression.rows();
+			_numOfCols = expression.cols();
+			_evaluate(static_cast<const E&>(expression));
+			return *this;
 		}
-			
+
 		/**
-		 * A method that overload the () operator.
-		 * @param row the row of the cell.
-		 * @param col the column of the cell.
-		 * @return a copy of the cell matrix[i,j].
-		 * @throws std::out_of_range exception.
+		 * A method that overload the += operator, the sum is computed in place.
+		 * @param other the matrix or expression to add, should be of the same dimensions as the
+		 * calling object.
+		 * @return a reference to the calling object.
+		 * @throws MatricesDimensionsError.
+		 * @throws std::system_error
+		 * @throws std::bad_alloc only for expressions that are not element-wise.
 		 */
-		const T& operator()(unsigned int row, unsigned int col) const
-		{	
-			try
-			{
-				return _matrix.at((row * _numOfCols) + col);	
-			}
-			catch (std::out_of_range &ex)
+		template<typename E>
+		Matrix<T>& operator+=(const MatrixExpression<E, T> &other)
+		{
+			if (_numOfRows != other.rows() || _numOfCols != other.cols())
 			{
-				throw std::out_of_range("Matrix indices are out of range");
+				throw MatricesDimensionsError("Cannot sum matrices from different dimensions");
 			}
+			_updateCells(static_cast<const E&>(other), &VectorKernels<T>::add, std::plus<T>(),
+						 IsElementWise<E>());
+			return *this;
 		}
 
 		/**
-		 * A method that overload the + operator.
-		 * @param other the matrix to be added, should be of the same dimensions as the
-		 * calling object.
-		 * @return a new matrix, the sum of the calling object
-		 * with the other matrix given by "other".
+		 * A method that overload the -= operator, the difference is computed in place.
+		 * @param other the matrix or expression to substract, should be of the same dimensions as
+		 * the calling object.
+		 * @return a reference to the calling object.
 		 * @throws MatricesDimensionsError.
 		 * @throws std::system_error
-		 * @throws std::bad_malloc
+		 * @throws std::bad_alloc only for expressions that are not element-wise.
 		 */
-		const Matrix<T> operator+(const Matrix<T> &other) const
+		template<typename E>
+		Matrix<T>& operator-=(const MatrixExpression<E, T> &other)
 		{
-			if (_numOfRows != other._numOfRows || _numOfCols != other._numOfCols)
+			if (_numOfRows != other.rows() || _numOfCols != other.cols())
 			{
-				throw MatricesDimensionsError("Cannot sum matrices from different dimensions");
+				throw MatricesDimensionsError("Cannot substract matrices "
+											  "from different dimesnions");
 			}
+			_updateCells(static_cast<const E&>(other), &VectorKernels<T>::sub, std::minus<T>(),
+						 IsElementWise<E>());
+			return *this;
+		}
 
-			Matrix<T> resMatrix(_numOfRows, _numOfCols);
+		/**
+		 * A method that overload the *= operator for a scalar, the cells are multiplied in place.
+		 * @param scalar the scalar to multiply by.
+		 * @return a reference to the calling object.
+		 * @throws std::system_error
+		 */
+		Matrix<T>& operator*=(const T &scalar)
+		{
+			auto scaleRows = [&](unsigned int first, unsigned int last)
+			{
+				for (unsigned int i = first; i < last; i++)
+				{
+					VectorKernels<T>::scale(scalar, _rowData(i), _rowData(i), _numOfCols);
+				}
+			};
 
 			// Case the matrix is in "parallel mode".
-			if (_isParallel) 
+			if (_isParallel)
 			{
-				_calculateParallel(other, resMatrix, &Matrix<T>::_calcRowSum);
+				ThreadPool::getInstance().parallelFor(0, _numOfRows, scaleRows);
 			}
 			// Case the matrix is in "sequential mode"
 			else
 			{
-				for (unsigned int i = 0; i < (_numOfRows * _numOfCols); i++)
-				{
-					resMatrix._matrix.at(i) = this->_matrix.at(i) + other._matrix.at(i);
-				}
+				scaleRows(0, _numOfRows);
 			}
-			return resMatrix;
+			return *this;
 		}
 
 		/**
-		 * A method that overload the - operator.
-		 * @param other the matrix to be substracted, should be of the same dimensions as the
-		 * calling object.
-		 * @return a new matrix, the substract of the other matrix given by "other"
-		 * from the calling object.
+		 * A method that overload the *= operator for a matrix, the product needs a new buffer
+		 * which replaces the calling object buffer.
+		 * @param other the matrix to be multiplied by.
+		 * @return a reference to the calling object.
+		 * @throws MatricesDimensionsError.
+		 * @throws std::system_error
+		 * @throws std::bad_alloc
+		 */
+		Matrix<T>& operator*=(const Matrix<T> &other)
+		{
+			*this = *this * other;
+			return *this;
+		}
+
+		/**
+		 * A method that overload the () operator.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return matrix[i,j] which reference to the matrix.
+		 * @throws std::out_of_range exception, unless MATRIX_UNCHECKED_ACCESS is defined.
 		 */
-		const Matrix<T> operator-(const Matrix<T> &other) const
+		T& operator()(unsigned int row, unsigned int col)
 		{
-			if (_numOfRows != other._numOfRows || _numOfCols != other._numOfCols)
+#ifdef MATRIX_UNCHECKED_ACCESS
+			return _cell(row, col);
+#else
+			try
 			{
-				throw MatricesDimensionsError("Cannot substract matrices"
-											  "from different dimesnions");
+				return _matrix.at((row * _numOfCols) + col);	
 			}
-			Matrix<T> resMatrix(_numOfRows, _numOfCols);
-			for (unsigned int i = 0; i < _matrix.size(); i++)
+			catch (std::out_of_range&)
 			{
-				resMatrix._matrix.at(i) = _matrix.at(i) - other._marix.at(i);
+				throw std::out_of_range("Matrix indices are out of range");
 			}
-			return resMatrix;
+#endif
+		}
+			
+		/**
+		 * A method that overload the () operator.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return a copy of the cell matrix[i,j].
+		 * @throws std::out_of_range exception, unless MATRIX_UNCHECKED_ACCESS is defined.
+		 */
+		const T& operator()(unsigned int row, unsigned int col) const
+		{	
+#ifdef MATRIX_UNCHECKED_ACCESS
+			return _cell(row, col);
+#else
+			try
+			{
+				return _matrix.at((row * _numOfCols) + col);	
+			}
+			catch (std::out_of_range &ex)
+			{
+				throw std::out_of_range("Matrix indices are out of range");
+			}
+#endif
 		}
 
 		/**
@@ -325,7 +916,7 @@ class Matrix
 		 * @throws std::system_error
 		 * @throws std::bad_malloc
 		 */
-		const Matrix<T> operator*(const Matrix<T> &other) const
+		Matrix<T> operator*(const Matrix<T> &other) const
 		{
 			if (_numOfCols != other._numOfRows)
 			{
@@ -339,72 +930,78 @@ class Matrix
 			// Case the matrix is in "parallel mode"
 			if (_isParallel) 
 			{
-				_calculateParallel(other, resMatrix, &Matrix<T>::_calcRowMul);
+				_calculateParallel(other, resMatrix, &Matrix<T>::_calcRowsMul);
 			}
 			// Case the matrix is in "sequential mode"
 			else
 			{
-				T tempSum(ZERO_ELEMENT_CTOR_INPUT);
-				/* ResultMatrix[i,j] is the sum from 0 to k-1 of right-handed matrix[i,k] * left-handed
-				 * matrix[k,j] */
-				for (unsigned int i = 0; i < resMatrix._numOfRows; i++)
-				{
-					for (unsigned int j = 0; j < resMatrix._numOfCols; j++) 
-					{
-						for (unsigned int k = 0; k < _numOfCols; k++)
-						{
-							tempSum += ((*this)(i, k) * other(k, j));
-						}
-						resMatrix(i, j) = tempSum;
-						tempSum = T(ZERO_ELEMENT_CTOR_INPUT);
-					}
-				}
+				_calcRowsMul(other, resMatrix, 0, _numOfRows);
 			}
 			return resMatrix;
 		}
 		
 		/**
-		 * A method that overload the == operator.
-		 * @param other the matrix to check if the calling object is equal to.
+		 * A friend function that overload the == operator, a friend so an expression on either
+		 * side(e.g. (a + b) == c) is evaluated to a matrix and compared like one.
+		 * @param left the left hand matrix.
+		 * @param right the right hand matrix.
 		 * @return true iff the matrices cells are equal and the number of rows and columns of 
 		 * the matrices are equal.
 		 */
-		bool operator==(Matrix<T> &other) const noexcept
+		friend bool operator==(const Matrix<T> &left, const Matrix<T> &right) noexcept
 		{
-			return ((_matrix == other._matrix) && (_numOfRows == other._numOfRows) 
-					&& (_numOfCols == other._numOfCols));
+			return ((left._matrix == right._matrix) && (left._numOfRows == right._numOfRows) 
+					&& (left._numOfCols == right._numOfCols));
 		}
 
 		/**
-		 * A method that overload the != operator.
-		 * @param other the matrix to check if the calling object is not equal to.
+		 * A friend function that overload the != operator.
+		 * @param left the left hand matrix.
+		 * @param right the right hand matrix.
 		 * @return true iff the matrices are not equal by the operator==.
 		 */
-		bool operator!=(Matrix<T> &other) const noexcept
+		friend bool operator!=(const Matrix<T> &left, const Matrix<T> &right) noexcept
 		{
-			return !(*this == other);
+			return !(left == right);
 		}
 
 		/**
-		 * A method that returns a transpose of the matrix.
-		 * @return a new object that is transposed to the calling object.
-		 * @throws std::bad_malloc
+		 * A method that transposes the matrix in place(the conjugate transpose in case of Complex
+		 * cells). A square matrix is transposed by swapping tiles across the diagonal without
+		 * another buffer(over the thread pool in "parallel mode"), any other matrix is replaced
+		 * by its transpose.
+		 * @return a reference to the calling object.
+		 * @throws std::system_error
+		 * @throws std::bad_alloc only for a matrix that is not square.
 		 */
-		Matrix<T> trans() const
+		Matrix<T>& transInPlace()
 		{
-			Matrix<T> resMatrix(_numOfCols, _numOfRows);
+			if (!isSquareMatrix())
+			{
+				*this = this->trans();
+				return *this;
+			}
 
-			/* newMatrix[j,i] = oldMatrix[i,j] for every i < oldMatrix.numOfRows, 
-			 * j < oldMatrix.numOfCols */
-			for (unsigned int i = 0; i < _numOfRows; i++)
+			unsigned int numOfTileRows = (_numOfRows + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+			auto transposeTileRows = [&](unsigned int first, unsigned int last)
 			{
-				for (unsigned int j = 0; j < _numOfCols; j++) 
+				for (unsigned int tileRow = first; tileRow < last; tileRow++)
 				{
-					resMatrix(j, i) = (*this)(i, j);
+					_transposeTilesInPlace(tileRow * TRANSPOSE_BLOCK);
 				}
-			}
+			};
 
-			return resMatrix;
+			// Case the matrix is in "parallel mode".
+			if (_isParallel)
+			{
+				ThreadPool::getInstance().parallelFor(0, numOfTileRows, transposeTileRows);
+			}
+			// Case the matrix is in "sequential mode"
+			else
+			{
+				transposeTileRows(0, numOfTileRows);
+			}
+			return *this;
 		}
 
 		/**
@@ -423,9 +1020,10 @@ class Matrix
 			T traceResult(ZERO_ELEMENT_CTOR_INPUT);
 
 			// Sum the values at the main diagonal to get the trace of the matrix
+			const T *cells = _matrix.data();
 			for (unsigned int i = 0; i < _numOfCols; i++) 
 			{
-				traceResult += (*this)(i, i);
+				traceResult += cells[i * (_numOfCols + 1)];
 			}	
 			return traceResult;
 		}
@@ -511,32 +1109,170 @@ class Matrix
 		}
 };
 
+/**
+ * An operator that sums a temporary matrix with an expression, the sum is computed in the
+ * temporary buffer instead of a new one.
+ * @param left the temporary matrix.
+ * @param right the expression to add, should be of the same dimensions as left.
+ * @return the sum, in the buffer of left.
+ * @throws MatricesDimensionsError.
+ * @throws std::system_error
+ */
+template<typename R, typename T>
+Matrix<T> operator+(Matrix<T> &&left, const MatrixExpression<R, T> &right)
+{
+	left += right;
+	return std::move(left);
+}
+
+/**
+ * An operator that sums an expression with a temporary matrix, the sum is computed in the
+ * temporary buffer instead of a new one.
+ * @param left the expression to add, should be of the same dimensions as right.
+ * @param right the temporary matrix.
+ * @return the sum, in the buffer of right.
+ * @throws MatricesDimensionsError.
+ * @throws std::system_error
+ */
+template<typename L, typename T>
+Matrix<T> operator+(const MatrixExpression<L, T> &left, Matrix<T> &&right)
+{
+	right += left;
+	return std::move(right);
+}
+
+/**
+ * An operator that sums two temporary matrices in the buffer of the left one.
+ * @param left the left hand temporary matrix.
+ * @param right the right hand temporary matrix.
+ * @return the sum, in the buffer of left.
+ * @throws MatricesDimensionsError.
+ * @throws std::system_error
+ */
+template<typename T>
+Matrix<T> operator+(Matrix<T> &&left, Matrix<T> &&right)
+{
+	left += right;
+	return std::move(left);
+}
+
+/**
+ * An operator that substracts an expression from a temporary matrix, the difference is computed
+ * in the temporary buffer instead of a new one.
+ * @param left the temporary matrix.
+ * @param right the expression to substract, should be of the same dimensions as left.
+ * @return the difference, in the buffer of left.
+ * @throws MatricesDimensionsError.
+ * @throws std::system_error
+ */
+template<typename R, typename T>
+Matrix<T> operator-(Matrix<T> &&left, const MatrixExpression<R, T> &right)
+{
+	left -= right;
+	return std::move(left);
+}
+
 // Initialization of static members.
 template<typename T>
 bool Matrix<T>::_isParallel = false;
 
 // Methods specializations.
 
+// The Complex tile kernels below access the cells as pairs of adjacent doubles(real, imaginary).
+static_assert(std::is_standard_layout<Complex>::value && sizeof(Complex) == 2 * sizeof(double),
+			  "Complex is expected to be laid out as two adjacent doubles");
+
 /**
- * A method that returns the conjugate transpose of the matrix.
- * @return a new object the conjugate transposed to the calling object.
- * @throws std::bad_malloc
+ * A method that adds the product of a GEMM_MR x kc block of the left hand matrix with a
+ * packed sliver to a full GEMM_MR x GEMM_NR tile of the solution.
+ * The real and imaginary parts are accumulated in registers, every product is computed as
+ * (ar * br - ai * bi, ar * bi + ai * br) like Complex::operator*.
+ * @param a the first cell of the left hand block.
+ * @param lda the distance between two rows of the left hand block.
+ * @param sliver the packed sliver of the right hand matrix.
+ * @param kc the shared dimension of the block and the sliver.
+ * @param c the first cell of the tile.
+ * @param ldc the distance between two rows of the tile.
  */
 template<>
-Matrix<Complex> Matrix<Complex>::trans() const
+inline void Matrix<Complex>::_mulTile(const Complex *a, unsigned int lda, const Complex *sliver, 
+									  unsigned int kc, Complex *c, unsigned int ldc) noexcept
 {
-	Matrix<Complex> resMatrix(_numOfCols, _numOfRows);
+	const double *aCells = reinterpret_cast<const double*>(a);
+	const double *bCells = reinterpret_cast<const double*>(sliver);
+	double *cCells = reinterpret_cast<double*>(c);
+	double accReal[GEMM_MR][GEMM_NR];
+	double accImaginary[GEMM_MR][GEMM_NR];
 
-	/* newMatrix[j,i] = oldMatrix[i,j] for every i < oldMatrix.numOfRows, 
-	 * j < oldMatrix.numOfCols */
-	for (unsigned int i = 0; i < _numOfRows; i++)
+	for (unsigned int r = 0; r < GEMM_MR; r++)
+	{
+		for (unsigned int j = 0; j < GEMM_NR; j++)
+		{
+			accReal[r][j] = cCells[2 * ((r * ldc) + j)];
+			accImaginary[r][j] = cCells[(2 * ((r * ldc) + j)) + 1];
+		}
+	}
+	for (unsigned int p = 0; p < kc; p++)
+	{
+		const double *b = bCells + (2 * p * GEMM_NR);
+		for (unsigned int r = 0; r < GEMM_MR; r++)
+		{
+			const double aReal = aCells[2 * ((r * lda) + p)];
+			const double aImaginary = aCells[(2 * ((r * lda) + p)) + 1];
+			for (unsigned int j = 0; j < GEMM_NR; j++)
+			{
+				accReal[r][j] += (aReal * b[2 * j]) - (aImaginary * b[(2 * j) + 1]);
+				accImaginary[r][j] += (aReal * b[(2 * j) + 1]) + (aImaginary * b[2 * j]);
+			}
+		}
+	}
+	for (unsigned int r = 0; r < GEMM_MR; r++)
 	{
-		for (unsigned int j = 0; j < _numOfCols; j++) 
+		for (unsigned int j = 0; j < GEMM_NR; j++)
 		{
-			resMatrix(j, i) = (*this)(i, j).conj();
+			cCells[2 * ((r * ldc) + j)] = accReal[r][j];
+			cCells[(2 * ((r * ldc) + j)) + 1] = accImaginary[r][j];
 		}
 	}
+}
+
+/**
+ * A method like _mulTile for the tiles at the bottom and right edges of the solution.
+ * @param a the first cell of the left hand block.
+ * @param lda the distance between two rows of the left hand block.
+ * @param sliver the packed sliver of the right hand matrix.
+ * @param kc the shared dimension of the block and the sliver.
+ * @param c the first cell of the tile.
+ * @param ldc the distance between two rows of the tile.
+ * @param mr the number of rows of the tile.
+ * @param nr the number of columns of the tile.
+ */
+template<>
+inline void Matrix<Complex>::_mulEdgeTile(const Complex *a, unsigned int lda, 
+										  const Complex *sliver, unsigned int kc, Complex *c, 
+										  unsigned int ldc, unsigned int mr, 
+										  unsigned int nr) noexcept
+{
+	const double *aCells = reinterpret_cast<const double*>(a);
+	const double *bCells = reinterpret_cast<const double*>(sliver);
+	double *cCells = reinterpret_cast<double*>(c);
 
-	return resMatrix;
+	for (unsigned int r = 0; r < mr; r++)
+	{
+		for (unsigned int j = 0; j < nr; j++)
+		{
+			double accReal = cCells[2 * ((r * ldc) + j)];
+			double accImaginary = cCells[(2 * ((r * ldc) + j)) + 1];
+			for (unsigned int p = 0; p < kc; p++)
+			{
+				const double *aCell = aCells + (2 * ((r * lda) + p));
+				const double *bCell = bCells + (2 * ((p * GEMM_NR) + j));
+				accReal += (aCell[0] * bCell[0]) - (aCell[1] * bCell[1]);
+				accImaginary += (aCell[0] * bCell[1]) + (aCell[1] * bCell[0]);
+			}
+			cCells[2 * ((r * ldc) + j)] = accReal;
+			cCells[(2 * ((r * ldc) + j)) + 1] = accImaginary;
+		}
+	}
 }
 #endif // MATRIX_HPP_
@@ -0,0 +1,193 @@
+/*
+ * -----------------------------------------------------------------------------
+ * This file contains a benchmark of the generic Matrix operations(+, *, trans
+ * and trace) over int, double and Complex cells, in sequential and parallel
+ * mode. See Benchmark.h for the command line options.
+ * -----------------------------------------------------------------------------
+ */
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "Complex.h"
+#include "Matrix.hpp"
+
+const unsigned int BENCHMARK_SEED = 2015;
+const unsigned int MAX_MUL_SIZE = 1024;
+const std::vector<unsigned int> DEFAULT_SIZES = {64, 256, 1024};
+
+/**
+ * A trait that gives the benchmark name of a cell type and creates its random cells.
+ */
+template<typename T>
+struct BenchmarkCell;
+
+template<>
+struct BenchmarkCell<int>
+{
+	static const unsigned int addFlops = 1; /**< The operations of a single + */
+	static const unsigned int mulAddFlops = 2; /**< The operations of a single a += b * c */
+
+	static std::string name()
+	{
+		return "int";
+	}
+
+	static int random(std::mt19937 &generator)
+	{
+		return std::uniform_int_distribution<int>(-100, 100)(generator);
+	}
+};
+
+template<>
+struct BenchmarkCell<double>
+{
+	static const unsigned int addFlops = 1; /**< The operations of a single + */
+	static const unsigned int mulAddFlops = 2; /**< The operations of a single a += b * c */
+
+	static std::string name()
+	{
+		return "double";
+	}
+
+	static double random(std::mt19937 &generator)
+	{
+		return std::uniform_real_distribution<double>(-1, 1)(generator);
+	}
+};
+
+template<>
+struct BenchmarkCell<Complex>
+{
+	static const unsigned int addFlops = 2; /**< The operations of a single + */
+	static const unsigned int mulAddFlops = 8; /**< The operations of a single a += b * c */
+
+	static std::string name()
+	{
+		return "Complex";
+	}
+
+	static Complex random(std::mt19937 &generator)
+	{
+		std::uniform_real_distribution<double> part(-1, 1);
+		double real = part(generator);
+		return Complex(real, part(generator));
+	}
+};
+
+/**
+ * A function that creates a square matrix of random cells, the same for every run.
+ * @param size the number of rows and cols.
+ * @return the matrix.
+ */
+template<typename T>
+Matrix<T> randomMatrix(unsigned int size)
+{
+	std::mt19937 generator(BENCHMARK_SEED);
+	std::vector<T> cells;
+	cells.reserve(size * size);
+	for (unsigned int i = 0; i < size * size; i++)
+	{
+		cells.push_back(BenchmarkCell<T>::random(generator));
+	}
+	return Matrix<T>(size, size, std::move(cells));
+}
+
+/**
+ * A function that changes the mode of the matrices without the message Matrix::setParallel
+ * prints, which would be mixed with the results.
+ * @param parallel true for the parallel mode.
+ */
+template<typename T>
+void setMode(bool parallel)
+{
+	std::streambuf *coutBuffer = std::cout.rdbuf(nullptr);
+	Matrix<T>::setParallel(parallel);
+	std::cout.rdbuf(coutBuffer);
+}
+
+/**
+ * A function that measures every operation on matrices of T of every size in both modes.
+ * @param options the benchmark options.
+ * @param results the vector to add the results to.
+ */
+template<typename T>
+void benchmarkType(const BenchmarkOptions &options, std::vector<BenchmarkResult> &results)
+{
+	const double cellBytes = sizeof(T);
+	const double sumFlops = BenchmarkCell<T>::addFlops;
+	const double mulFlops = BenchmarkCell<T>::mulAddFlops;
+
+	for (bool parallel : {false, true})
+	{
+		setMode<T>(parallel);
+		for (unsigned int size : options.sizes)
+		{
+			Matrix<T> left = randomMatrix<T>(size);
+			Matrix<T> right = left.trans();
+			double cells = static_cast<double>(size) * size;
+			BenchmarkResult result;
+			result.library = "Matrix";
+			result.type = BenchmarkCell<T>::name();
+			result.mode = parallel ? "parallel" : "sequential";
+			result.size = size;
+
+			result.operation = "+";
+			measure(options, [&]() { Matrix<T> sum = left + right; }, sumFlops * cells,
+					3 * cellBytes * cells, result);
+			results.push_back(result);
+
+			if (size <= MAX_MUL_SIZE)
+			{
+				result.operation = "*";
+				measure(options, [&]() { Matrix<T> product = left * right; },
+						mulFlops * cells * size, 3 * cellBytes * cells, result);
+				results.push_back(result);
+			}
+
+			result.operation = "trans";
+			measure(options, [&]() { Matrix<T> transposed = left.trans(); }, 0,
+					2 * cellBytes * cells, result);
+			results.push_back(result);
+
+			result.operation = "trace";
+			T trace;
+			measure(options, [&]() { trace = left.trace(); }, sumFlops * size,
+					cellBytes * size, result);
+			results.push_back(result);
+			std::cerr << result.type << ' ' << result.mode << ' ' << size << " done(trace "
+					  << trace << ")" << std::endl;
+		}
+	}
+	setMode<T>(false);
+}
+
+/**
+ * The main function, runs the benchmark and writes its results.
+ * @param argc the number of arguments.
+ * @param argv the arguments, see Benchmark.h.
+ * @return 0 on success, 1 in case of bad arguments.
+ */
+int main(int argc, char *argv[])
+{
+	BenchmarkOptions options;
+	try
+	{
+		options = parseBenchmarkOptions(argc, argv, DEFAULT_SIZES);
+	}
+	catch (std::exception &ex)
+	{
+		std::cerr << "Usage: MatrixBenchmark [--sizes n1,n2,...] [--samples n] [--warmup n] "
+					 "[--format csv|json] [--output file]\n" << ex.what() << std::endl;
+		return 1;
+	}
+
+	std::vector<BenchmarkResult> results;
+	benchmarkType<int>(options, results);
+	benchmarkType<double>(options, results);
+	benchmarkType<Complex>(options, results);
+	writeResults(options, results);
+	return 0;
+}
@@ -0,0 +1,646 @@
+#ifndef MATRIX_EXPRESSION_HPP_
+#define MATRIX_EXPRESSION_HPP_
+
+#include <type_traits>
+#include "Complex.h"
+#include "MatricesDimensionsError.h"
+#include "VectorKernels.h"
+
+template<typename T>
+class Matrix;
+
+template<typename E, typename T>
+class MatrixTranspose;
+
+/**
+ * A template class that is the base of every lazily evaluated matrix expression.
+ * An expression only describes how to compute its cells, the cells are computed in a single pass
+ * when the expression is assigned to a Matrix, a row at a time(see evalRow).
+ * Expressions keep references to the matrices they were built from, so they should be assigned
+ * to a Matrix in the same statement they were created at.
+ * @tparam E the derived expression type(Curiously recurring template pattern).
+ * @tparam T the type of the expression cells.
+ */
+template<typename E, typename T>
+class MatrixExpression
+{
+	public:
+		/**
+		 * A method that returns the number of rows of the expression.
+		 * @return the number of rows.
+		 */
+		unsigned int rows() const noexcept
+		{
+			return static_cast<const E&>(*this).rows();
+		}
+
+		/**
+		 * A method that returns the number of cols of the expression.
+		 * @return the number of cols.
+		 */
+		unsigned int cols() const noexcept
+		{
+			return static_cast<const E&>(*this).cols();
+		}
+
+		/**
+		 * A method that computes a single cell of the expression, the indices are not checked.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return the value of expression[row,col].
+		 */
+		T cell(unsigned int row, unsigned int col) const
+		{
+			return static_cast<const E&>(*this)._cell(row, col);
+		}
+
+		/**
+		 * A method that computes a full row of the expression.
+		 * @param row the row to compute, not checked.
+		 * @param dest the array to save the row cells at, of cols() cells.
+		 */
+		void evalRow(unsigned int row, T *dest) const
+		{
+			static_cast<const E&>(*this)._evalRow(row, dest);
+		}
+
+		/**
+		 * A method that returns whether the expression reads the cells of a given matrix, in which
+		 * case it can not be evaluated into the buffer of that matrix.
+		 * @param matrix the matrix.
+		 * @return true iff the matrix is an operand of the expression.
+		 */
+		bool refersTo(const Matrix<T> &matrix) const noexcept
+		{
+			return static_cast<const E&>(*this)._refersTo(matrix);
+		}
+
+		/**
+		 * A method that returns the transpose of the expression, the conjugate transpose in case
+		 * of Complex cells.
+		 * @return a lazy expression transposed to the calling object.
+		 */
+		MatrixTranspose<E, T> trans() const
+		{
+			return MatrixTranspose<E, T>(static_cast<const E&>(*this));
+		}
+};
+
+/**
+ * A trait that defines how an expression keeps its operands, matrices are kept by reference and
+ * the other expressions, which are small temporaries, are kept by value.
+ */
+template<typename E>
+struct ExpressionOperand
+{
+	typedef const E type; /**< The type of the kept operand */
+};
+
+template<typename T>
+struct ExpressionOperand<Matrix<T> >
+{
+	typedef const Matrix<T>& type; /**< The type of the kept operand */
+};
+
+/**
+ * A trait that names the type of the cells, used for the scalar of an operator so its type is
+ * not deduced from the scalar too, and a literal of another type(e.g. 2 * matrix of doubles) is
+ * converted to the cell type.
+ */
+template<typename T>
+struct ExpressionScalar
+{
+	typedef T type; /**< The type of the scalar */
+};
+
+/**
+ * A trait that gives the expression nodes direct access to the rows of their operands, so the
+ * rows are computed by the VectorKernels without copying the operands first.
+ * Only a Matrix keeps its cells, so the row of any other expression is nullptr.
+ */
+template<typename E, typename T>
+struct ExpressionRow
+{
+	/**
+	 * A function that returns the cells of a row of the expression.
+	 * @return nullptr, the row should be computed by evalRow.
+	 */
+	static const T* cells(const E&, unsigned int) noexcept
+	{
+		return nullptr;
+	}
+};
+
+template<typename T>
+struct ExpressionRow<Matrix<T>, T>
+{
+	/**
+	 * A function that returns the cells of a row of the matrix.
+	 * @param matrix the matrix.
+	 * @param row the row, not checked.
+	 * @return a pointer to matrix[row,0].
+	 */
+	static const T* cells(const Matrix<T> &matrix, unsigned int row) noexcept
+	{
+		return matrix._rowData(row);
+	}
+};
+
+/**
+ * A trait that tells whether every cell of an expression depends only on the same cell of its
+ * operands, so it can be computed into one of its operands in place. False unless specialized.
+ */
+template<typename E>
+struct IsElementWise : std::false_type
+{
+};
+
+template<typename T>
+struct IsElementWise<Matrix<T> > : std::true_type
+{
+};
+
+/**
+ * A template class represents the lazy sum of two expressions.
+ */
+template<typename L, typename R, typename T>
+class MatrixSum : public MatrixExpression<MatrixSum<L, R, T>, T>
+{
+	public:
+		/**
+		 * A ctor used to create the sum of two expressions.
+		 * @param left the left hand expression.
+		 * @param right the right hand expression.
+		 * @throws MatricesDimensionsError.
+		 */
+		MatrixSum(const MatrixExpression<L, T> &left, const MatrixExpression<R, T> &right) :
+				  _left(static_cast<const L&>(left)), _right(static_cast<const R&>(right))
+		{
+			if (left.rows() != right.rows() || left.cols() != right.cols())
+			{
+				throw MatricesDimensionsError("Cannot sum matrices from different dimensions");
+			}
+		}
+
+		/**
+		 * A method that returns the number of rows of the expression.
+		 * @return the number of rows.
+		 */
+		unsigned int rows() const noexcept
+		{
+			return _left.rows();
+		}
+
+		/**
+		 * A method that returns the number of cols of the expression.
+		 * @return the number of cols.
+		 */
+		unsigned int cols() const noexcept
+		{
+			return _left.cols();
+		}
+
+	private:
+		friend class MatrixExpression<MatrixSum<L, R, T>, T>;
+
+		typename ExpressionOperand<L>::type _left; /**< The left hand expression */
+		typename ExpressionOperand<R>::type _right; /**< The right hand expression */
+
+		/**
+		 * A method that returns whether the expression reads the cells of a given matrix.
+		 * @param matrix the matrix.
+		 * @return true iff the matrix is an operand of one of the expressions.
+		 */
+		bool _refersTo(const Matrix<T> &matrix) const noexcept
+		{
+			return _left.refersTo(matrix) || _right.refersTo(matrix);
+		}
+
+		/**
+		 * A method that computes a single cell of the expression.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return left[row,col] + right[row,col].
+		 */
+		T _cell(unsigned int row, unsigned int col) const
+		{
+			return _left.cell(row, col) + _right.cell(row, col);
+		}
+		/**
+		 * A method that computes a row of the expression.
+		 * @param row the row to compute.
+		 * @param dest the array to save the row cells at.
+		 */
+		void _evalRow(unsigned int row, T *dest) const
+		{
+			const T *left = ExpressionRow<L, T>::cells(_left, row);
+			if (left == nullptr)
+			{
+				_left.evalRow(row, dest);
+				left = dest;
+			}
+
+			const T *right = ExpressionRow<R, T>::cells(_right, row);
+			if (right != nullptr)
+			{
+				VectorKernels<T>::add(left, right, dest, cols());
+				return;
+			}
+			for (unsigned int col = 0; col < cols(); col++)
+			{
+				dest[col] = left[col] + _right.cell(row, col);
+			}
+		}
+};
+
+/**
+ * A template class represents the lazy difference of two expressions.
+ */
+template<typename L, typename R, typename T>
+class MatrixDifference : public MatrixExpression<MatrixDifference<L, R, T>, T>
+{
+	public:
+		/**
+		 * A ctor used to create the difference of two expressions.
+		 * @param left the left hand expression.
+		 * @param right the right hand expression.
+		 * @throws MatricesDimensionsError.
+		 */
+		MatrixDifference(const MatrixExpression<L, T> &left, 
+						 const MatrixExpression<R, T> &right) : 
+						 _left(static_cast<const L&>(left)), _right(static_cast<const R&>(right))
+		{
+			if (left.rows() != right.rows() || left.cols() != right.cols())
+			{
+				throw MatricesDimensionsError("Cannot substract matrices "
+											  "from different dimesnions");
+			}
+		}
+
+		/**
+		 * A method that returns the number of rows of the expression.
+		 * @return the number of rows.
+		 */
+		unsigned int rows() const noexcept
+		{
+			return _left.rows();
+		}
+
+		/**
+		 * A method that returns the number of cols of the expression.
+		 * @return the number of cols.
+		 */
+		unsigned int cols() const noexcept
+		{
+			return _left.cols();
+		}
+
+	private:
+		friend class MatrixExpression<MatrixDifference<L, R, T>, T>;
+
+		typename ExpressionOperand<L>::type _left; /**< The left hand expression */
+		typename ExpressionOperand<R>::type _right; /**< The right hand expression */
+
+		/**
+		 * A method that returns whether the expression reads the cells of a given matrix.
+		 * @param matrix the matrix.
+		 * @return true iff the matrix is an operand of one of the expressions.
+		 */
+		bool _refersTo(const Matrix<T> &matrix) const noexcept
+		{
+			return _left.refersTo(matrix) || _right.refersTo(matrix);
+		}
+
+		/**
+		 * A method that computes a single cell of the expression.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return left[row,col] - right[row,col].
+		 */
+		T _cell(unsigned int row, unsigned int col) const
+		{
+			return _left.cell(row, col) - _right.cell(row, col);
+		}
+		/**
+		 * A method that computes a row of the expression.
+		 * @param row the row to compute.
+		 * @param dest the array to save the row cells at.
+		 */
+		void _evalRow(unsigned int row, T *dest) const
+		{
+			const T *left = ExpressionRow<L, T>::cells(_left, row);
+			if (left == nullptr)
+			{
+				_left.evalRow(row, dest);
+				left = dest;
+			}
+
+			const T *right = ExpressionRow<R, T>::cells(_right, row);
+			if (right != nullptr)
+			{
+				VectorKernels<T>::sub(left, right, dest, cols());
+				return;
+			}
+			for (unsigned int col = 0; col < cols(); col++)
+			{
+				dest[col] = left[col] - _right.cell(row, col);
+			}
+		}
+};
+
+/**
+ * A template class represents the lazy multipication of an expression by a scalar.
+ */
+template<typename E, typename T>
+class MatrixScalarProduct : public MatrixExpression<MatrixScalarProduct<E, T>, T>
+{
+	public:
+		/**
+		 * A ctor used to create the multipication of an expression by a scalar.
+		 * @param scalar the scalar to multiply by.
+		 * @param expression the multiplied expression.
+		 */
+		MatrixScalarProduct(const T &scalar, const E &expression) : _scalar(scalar),
+																	_expression(expression)
+		{
+		}
+
+		/**
+		 * A method that returns the number of rows of the expression.
+		 * @return the number of rows.
+		 */
+		unsigned int rows() const noexcept
+		{
+			return _expression.rows();
+		}
+
+		/**
+		 * A method that returns the number of cols of the expression.
+		 * @return the number of cols.
+		 */
+		unsigned int cols() const noexcept
+		{
+			return _expression.cols();
+		}
+
+	private:
+		friend class MatrixExpression<MatrixScalarProduct<E, T>, T>;
+
+		T _scalar; /**< The scalar to multiply by */
+		typename ExpressionOperand<E>::type _expression; /**< The multiplied expression */
+
+		/**
+		 * A method that returns whether the expression reads the cells of a given matrix.
+		 * @param matrix the matrix.
+		 * @return true iff the matrix is an operand of the expression.
+		 */
+		bool _refersTo(const Matrix<T> &matrix) const noexcept
+		{
+			return _expression.refersTo(matrix);
+		}
+
+		/**
+		 * A method that computes a single cell of the expression.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return scalar * expression[row,col].
+		 */
+		T _cell(unsigned int row, unsigned int col) const
+		{
+			return _scalar * _expression.cell(row, col);
+		}
+
+		/**
+		 * A method that computes a row of the expression.
+		 * @param row the row to compute.
+		 * @param dest the array to save the row cells at.
+		 */
+		void _evalRow(unsigned int row, T *dest) const
+		{
+			const T *cells = ExpressionRow<E, T>::cells(_expression, row);
+			if (cells == nullptr)
+			{
+				_expression.evalRow(row, dest);
+				cells = dest;
+			}
+			VectorKernels<T>::scale(_scalar, cells, dest, cols());
+		}
+};
+
+/**
+ * A function that returns the cell of a transposed expression.
+ * @param value the cell of the original expression.
+ * @return the same value.
+ */
+template<typename T>
+inline T transposedCell(const T &value)
+{
+	return value;
+}
+
+/**
+ * A function that returns the cell of a transposed Complex expression, which is conjugated.
+ * @param value the cell of the original expression.
+ * @return the conjugate of the value.
+ */
+inline Complex transposedCell(const Complex &value)
+{
+	return value.conj();
+}
+
+template<typename L, typename R, typename T>
+struct IsElementWise<MatrixSum<L, R, T> > :
+	std::integral_constant<bool, IsElementWise<L>::value && IsElementWise<R>::value>
+{
+};
+
+template<typename L, typename R, typename T>
+struct IsElementWise<MatrixDifference<L, R, T> > :
+	std::integral_constant<bool, IsElementWise<L>::value && IsElementWise<R>::value>
+{
+};
+
+template<typename E, typename T>
+struct IsElementWise<MatrixScalarProduct<E, T> > : IsElementWise<E>
+{
+};
+
+/**
+ * A template class represents the lazy transpose of an expression, the conjugate transpose in
+ * case of Complex cells.
+ */
+template<typename E, typename T>
+class MatrixTranspose : public MatrixExpression<MatrixTranspose<E, T>, T>
+{
+	public:
+		/**
+		 * A ctor used to create the transpose of an expression.
+		 * @param expression the transposed expression.
+		 */
+		explicit MatrixTranspose(const E &expression) : _expression(expression)
+		{
+		}
+
+		/**
+		 * A method that returns the number of rows of the expression.
+		 * @return the number of rows.
+		 */
+		unsigned int rows() const noexcept
+		{
+			return _expression.cols();
+		}
+
+		/**
+		 * A method that returns the number of cols of the expression.
+		 * @return the number of cols.
+		 */
+		unsigned int cols() const noexcept
+		{
+			return _expression.rows();
+		}
+
+		/**
+		 * A method that returns the transposed expression.
+		 * @return a const reference to the transposed expression.
+		 */
+		const E& operand() const noexcept
+		{
+			return _expression;
+		}
+
+	private:
+		friend class MatrixExpression<MatrixTranspose<E, T>, T>;
+
+		typename ExpressionOperand<E>::type _expression; /**< The transposed expression */
+
+		/**
+		 * A method that returns whether the expression reads the cells of a given matrix.
+		 * @param matrix the matrix.
+		 * @return true iff the matrix is an operand of the expression.
+		 */
+		bool _refersTo(const Matrix<T> &matrix) const noexcept
+		{
+			return _expression.refersTo(matrix);
+		}
+
+		/**
+		 * A method that computes a single cell of the expression.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return expression[col,row], conjugated in case of Complex cells.
+		 */
+		T _cell(unsigned int row, unsigned int col) const
+		{
+			return transposedCell(_expression.cell(col, row));
+		}
+
+		/**
+		 * A method that computes a row of the expression, which is a column of the transposed
+		 * expression.
+		 * @param row the row to compute.
+		 * @param dest the array to save the row cells at.
+		 */
+		void _evalRow(unsigned int row, T *dest) const
+		{
+			for (unsigned int col = 0; col < cols(); col++)
+			{
+				dest[col] = transposedCell(_expression.cell(col, row));
+			}
+		}
+};
+
+/**
+ * An operator that returns the lazy sum of two expressions.
+ * @param left the left hand expression.
+ * @param right the right hand expression, should be of the same dimensions as left.
+ * @return an expression of left + right.
+ * @throws MatricesDimensionsError.
+ */
+template<typename L, typename R, typename T>
+MatrixSum<L, R, T> operator+(const MatrixExpression<L, T> &left,
+							 const MatrixExpression<R, T> &right)
+{
+	return MatrixSum<L, R, T>(left, right);
+}
+
+/**
+ * An operator that returns the lazy difference of two expressions.
+ * @param left the left hand expression.
+ * @param right the right hand expression, should be of the same dimensions as left.
+ * @return an expression of left - right.
+ * @throws MatricesDimensionsError.
+ */
+template<typename L, typename R, typename T>
+MatrixDifference<L, R, T> operator-(const MatrixExpression<L, T> &left,
+									const MatrixExpression<R, T> &right)
+{
+	return MatrixDifference<L, R, T>(left, right);
+}
+
+/**
+ * An operator that returns the lazy multipication of a scalar by an expression.
+ * @param scalar the scalar to multiply by.
+ * @param expression the multiplied expression.
+ * @return an expression of scalar * expression.
+ */
+template<typename E, typename T>
+MatrixScalarProduct<E, T> operator*(const typename ExpressionScalar<T>::type &scalar,
+									const MatrixExpression<E, T> &expression)
+{
+	return MatrixScalarProduct<E, T>(scalar, static_cast<const E&>(expression));
+}
+
+/**
+ * An operator that returns the lazy multipication of an expression by a scalar.
+ * @param expression the multiplied expression.
+ * @param scalar the scalar to multiply by.
+ * @return an expression of scalar * expression.
+ */
+template<typename E, typename T>
+MatrixScalarProduct<E, T> operator*(const MatrixExpression<E, T> &expression,
+									const typename ExpressionScalar<T>::type &scalar)
+{
+	return MatrixScalarProduct<E, T>(scalar, static_cast<const E&>(expression));
+}
+
+/**
+ * A function that evaluates an expression into a matrix.
+ * @param expression the expression to evaluate.
+ * @return a new matrix contains the expression cells.
+ * @throws std::bad_alloc
+ */
+template<typename E, typename T>
+Matrix<T> evaluate(const MatrixExpression<E, T> &expression)
+{
+	return Matrix<T>(expression);
+}
+
+/**
+ * A function that "evaluates" a matrix, which is already evaluated, so no copy is made.
+ * @param matrix the matrix.
+ * @return a reference to the given matrix.
+ */
+template<typename T>
+const Matrix<T>& evaluate(const Matrix<T> &matrix) noexcept
+{
+	return matrix;
+}
+
+/**
+ * An operator that multiplies two expressions, the operands are evaluated into matrices(unless
+ * they are matrices already) and multiplied by Matrix::operator*.
+ * @param left the left hand expression.
+ * @param right the right hand expression.
+ * @return a new matrix, the multipication of left with right.
+ * @throws MatricesDimensionsError.
+ * @throws std::system_error
+ * @throws std::bad_alloc
+ */
+template<typename L, typename R, typename T>
+Matrix<T> operator*(const MatrixExpression<L, T> &left,
+						  const MatrixExpression<R, T> &right)
+{
+	return evaluate(static_cast<const L&>(left)) * evaluate(static_cast<const R&>(right));
+}
+
+#endif // MATRIX_EXPRESSION_HPP_
@@ -0,0 +1,335 @@
+#ifndef MATRIX_FILE_H_
+#define MATRIX_FILE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Complex.h"
+#include "Matrix.hpp"
+#include "MatrixFileError.h"
+
+/*
+ * The binary matrix file format:
+ * A MatrixFileHeader followed by zero padding up to header.dataOffset, followed by the rows*cols
+ * cells in row-major order, as they are laid out in memory(native byte order).
+ * The data offset is a multiple of header.alignment, so a mapped file can be read in place.
+ */
+
+const char MATRIX_FILE_MAGIC[4] = {'H', 'M', 'T', 'X'};
+const uint32_t MATRIX_FILE_VERSION = 1;
+const uint32_t MATRIX_FILE_ALIGNMENT = 64;
+
+/**
+ * The header at the beginning of every binary matrix file.
+ */
+struct MatrixFileHeader
+{
+	char magic[4]; /**< MATRIX_FILE_MAGIC */
+	uint32_t version; /**< MATRIX_FILE_VERSION */
+	uint32_t typeTag; /**< The type of the cells(see MatrixFileType) */
+	uint32_t alignment; /**< The alignment of the data offset */
+	uint64_t rows; /**< The number of rows */
+	uint64_t cols; /**< The number of cols */
+	uint64_t dataOffset; /**< The offset of the first cell from the beginning of the file */
+};
+
+/**
+ * A trait that gives the type tag of the cells of a binary matrix file, only the types below
+ * can be stored.
+ */
+template<typename T>
+struct MatrixFileType;
+
+template<>
+struct MatrixFileType<int>
+{
+	static const uint32_t tag = 1; /**< The type tag */
+};
+
+template<>
+struct MatrixFileType<double>
+{
+	static const uint32_t tag = 2; /**< The type tag */
+};
+
+template<>
+struct MatrixFileType<Complex>
+{
+	static const uint32_t tag = 3; /**< The type tag */
+};
+
+/**
+ * A template class represents a read-only matrix that is mapped from a binary matrix file, the
+ * cells are read in place without copying them.
+ * A mapped matrix is a lazy expression, so it can be an operand of the Matrix operations or be
+ * assigned to a Matrix, which copies it once.
+ */
+template<typename T>
+class MappedMatrix : public MatrixExpression<MappedMatrix<T>, T>
+{
+	public:
+		/**
+		 * A ctor used to map a binary matrix file.
+		 * @param fileName the path of the file.
+		 * @throws MatrixFileError in case the file cannot be mapped or is not a valid matrix of T.
+		 */
+		explicit MappedMatrix(const std::string &fileName) : _mapping(MAP_FAILED), _mappingSize(0),
+															 _cells(nullptr), _numOfRows(0),
+															 _numOfCols(0)
+		{
+			int fd = open(fileName.c_str(), O_RDONLY);
+			if (fd < 0)
+			{
+				throw MatrixFileError("Cannot open the matrix file " + fileName);
+			}
+
+			struct stat fileStat;
+			if (fstat(fd, &fileStat) != 0 ||
+				static_cast<uint64_t>(fileStat.st_size) < sizeof(MatrixFileHeader))
+			{
+				close(fd);
+				throw MatrixFileError("The matrix file " + fileName + " is too short");
+			}
+			_mappingSize = fileStat.st_size;
+			_mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+			if (_mapping == MAP_FAILED)
+			{
+				throw MatrixFileError("Cannot map the matrix file " + fileName);
+			}
+			madvise(_mapping, _mappingSize, MADV_SEQUENTIAL);
+
+			try
+			{
+				_readHeader(fileName);
+			}
+			catch (...)
+			{
+				munmap(_mapping, _mappingSize);
+				throw;
+			}
+		}
+
+		/**
+		 * A move ctor, the other matrix is left unmapped.
+		 * @param other the matrix to move.
+		 */
+		MappedMatrix(MappedMatrix<T> &&other) noexcept : _mapping(other._mapping),
+														 _mappingSize(other._mappingSize),
+														 _cells(other._cells),
+														 _numOfRows(other._numOfRows),
+														 _numOfCols(other._numOfCols)
+		{
+			other._mapping = MAP_FAILED;
+			other._cells = nullptr;
+			other._numOfRows = 0;
+			other._numOfCols = 0;
+		}
+
+		MappedMatrix(const MappedMatrix<T>&) = delete;
+		MappedMatrix<T>& operator=(const MappedMatrix<T>&) = delete;
+
+		/**
+		 * The destructor, unmaps the file.
+		 */
+		~MappedMatrix() noexcept
+		{
+			if (_mapping != MAP_FAILED)
+			{
+				munmap(_mapping, _mappingSize);
+			}
+		}
+
+		/**
+		 * A method that overload the () operator.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return a const reference to the cell matrix[i,j].
+		 * @throws std::out_of_range exception, unless MATRIX_UNCHECKED_ACCESS is defined.
+		 */
+		const T& operator()(unsigned int row, unsigned int col) const
+		{
+#ifndef MATRIX_UNCHECKED_ACCESS
+			if (row >= _numOfRows || col >= _numOfCols)
+			{
+				throw std::out_of_range("Matrix indices are out of range");
+			}
+#endif
+			return _cells[(static_cast<size_t>(row) * _numOfCols) + col];
+		}
+
+		/**
+		 * A method that returns the number of rows of the matrix.
+		 * @return the number of rows.
+		 */
+		unsigned int rows() const noexcept
+		{
+			return _numOfRows;
+		}
+
+		/**
+		 * A method that returns the number of cols of the matrix.
+		 * @return the number of cols.
+		 */
+		unsigned int cols() const noexcept
+		{
+			return _numOfCols;
+		}
+
+	private:
+		friend class MatrixExpression<MappedMatrix<T>, T>;
+		friend struct ExpressionRow<MappedMatrix<T>, T>;
+
+		void *_mapping; /**< The mapping of the file */
+		size_t _mappingSize; /**< The size of the mapping */
+		const T *_cells; /**< The first cell, inside the mapping */
+		unsigned int _numOfRows; /**< The number of rows */
+		unsigned int _numOfCols; /**< The number of cols */
+
+		/**
+		 * A method that validates the header of the mapped file and points to its cells.
+		 * @param fileName the path of the file, for the error messages.
+		 * @throws MatrixFileError in case the file is not a valid matrix of T.
+		 */
+		void _readHeader(const std::string &fileName)
+		{
+			MatrixFileHeader header;
+			std::memcpy(&header, _mapping, sizeof(header));
+			if (std::memcmp(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+				header.version != MATRIX_FILE_VERSION)
+			{
+				throw MatrixFileError(fileName + " is not a binary matrix file");
+			}
+			if (header.typeTag != MatrixFileType<T>::tag)
+			{
+				throw MatrixFileError("The cells of " + fileName + " are of a different type");
+			}
+			// The cells must not overlap the header and must start where the writer aligned them.
+			if (header.alignment == 0 || header.dataOffset < sizeof(header) ||
+				header.dataOffset % header.alignment != 0)
+			{
+				throw MatrixFileError("The data offset of " + fileName + " is damaged");
+			}
+			if (header.rows > UINT32_MAX || header.cols > UINT32_MAX ||
+				header.dataOffset % alignof(T) != 0 || header.dataOffset > _mappingSize ||
+				(header.cols != 0 && header.rows > ((_mappingSize - header.dataOffset) / sizeof(T)) /
+												   header.cols))
+			{
+				throw MatrixFileError("The dimensions of " + fileName + " do not match its size");
+			}
+
+			_numOfRows = header.rows;
+			_numOfCols = header.cols;
+			_cells = reinterpret_cast<const T*>(static_cast<const char*>(_mapping) +
+												header.dataOffset);
+		}
+
+		/**
+		 * A method that returns a cell without checking the indices.
+		 * @param row the row of the cell.
+		 * @param col the column of the cell.
+		 * @return a const reference to matrix[row,col].
+		 */
+		const T& _cell(unsigned int row, unsigned int col) const noexcept
+		{
+			return _cells[(static_cast<size_t>(row) * _numOfCols) + col];
+		}
+
+		/**
+		 * A method that copies a row of the matrix, used when the matrix is the operand of an
+		 * expression.
+		 * @param row the row to copy.
+		 * @param dest the array to copy the row cells to.
+		 */
+		void _evalRow(unsigned int row, T *dest) const
+		{
+			std::copy(&_cell(row, 0), &_cell(row, 0) + _numOfCols, dest);
+		}
+};
+
+template<typename T>
+struct ExpressionOperand<MappedMatrix<T> >
+{
+	typedef const MappedMatrix<T>& type; /**< The type of the kept operand */
+};
+
+template<typename T>
+struct IsElementWise<MappedMatrix<T> > : std::true_type
+{
+};
+
+template<typename T>
+struct ExpressionRow<MappedMatrix<T>, T>
+{
+	/**
+	 * A function that returns the cells of a row of the mapped matrix.
+	 * @param matrix the mapped matrix.
+	 * @param row the row, not checked.
+	 * @return a pointer to matrix[row,0].
+	 */
+	static const T* cells(const MappedMatrix<T> &matrix, unsigned int row) noexcept
+	{
+		return &matrix._cell(row, 0);
+	}
+};
+
+/**
+ * A function that writes a matrix, or the result of an expression, to a binary matrix file.
+ * The rows are written one after the other, so an expression is computed a row at a time without
+ * creating the whole result in memory.
+ * @param fileName the path of the file, it is overwritten.
+ * @param expression the matrix or expression to write.
+ * @throws MatrixFileError in case the file cannot be written.
+ * @throws std::bad_alloc
+ */
+template<typename E, typename T>
+void writeMatrixFile(const std::string &fileName, const MatrixExpression<E, T> &expression)
+{
+	std::ofstream output(fileName, std::ios::binary | std::ios::trunc);
+	if (!output)
+	{
+		throw MatrixFileError("Cannot open the matrix file " + fileName);
+	}
+
+	MatrixFileHeader header;
+	std::memcpy(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic));
+	header.version = MATRIX_FILE_VERSION;
+	header.typeTag = MatrixFileType<T>::tag;
+	header.alignment = MATRIX_FILE_ALIGNMENT;
+	header.rows = expression.rows();
+	header.cols = expression.cols();
+	header.dataOffset = ((sizeof(header) + MATRIX_FILE_ALIGNMENT - 1) / MATRIX_FILE_ALIGNMENT) *
+						MATRIX_FILE_ALIGNMENT;
+
+	const char padding[MATRIX_FILE_ALIGNMENT] = {};
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(padding, header.dataOffset - sizeof(header));
+
+	const E &cells = static_cast<const E&>(expression);
+	std::vector<T> rowBuffer;
+	for (unsigned int row = 0; row < expression.rows(); row++)
+	{
+		const T *rowCells = ExpressionRow<E, T>::cells(cells, row);
+		if (rowCells == nullptr)
+		{
+			rowBuffer.resize(expression.cols());
+			expression.evalRow(row, rowBuffer.data());
+			rowCells = rowBuffer.data();
+		}
+		output.write(reinterpret_cast<const char*>(rowCells), sizeof(T) * expression.cols());
+	}
+
+	if (!output.flush())
+	{
+		throw MatrixFileError("Cannot write the matrix file " + fileName);
+	}
+}
+
+#endif // MATRIX_FILE_H_
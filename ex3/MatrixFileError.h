@@ -0,0 +1,24 @@
+#ifndef MATRIX_FILE_ERROR_H_
+#define MATRIX_FILE_ERROR_H_
+
+#include <string>
+#include <stdexcept>
+
+/**
+ * A class that represents an exception that is thrown when a binary matrix file cannot be read or
+ * written, or its content is not a valid matrix of the requested type.
+ */
+class MatrixFileError : public std::runtime_error
+{
+	public:
+		/**
+		 * Default constructor.
+		 * @param errorMessage the error message to print.
+		 */
+		explicit MatrixFileError(std::string errorMessage) : std::runtime_error(errorMessage)
+		{
+		}
+
+	private:
+};
+#endif
@@ -0,0 +1,291 @@
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const unsigned int MIN_POOL_THREADS = 1;
+const unsigned int BLOCKS_PER_THREAD = 4;
+
+/**
+ * A class that represents a process-wide pool of worker threads.
+ * Every worker owns a queue of tasks, it takes tasks from the back of its own queue and when it
+ * is empty it steals tasks from the front of the other workers queues, so an idle worker will
+ * always take work from a busy one.
+ * The thread that submits a job helps executing it, so the pool holds one thread less than the
+ * hardware concurrency.
+ */
+class ThreadPool
+{
+	public:
+		/**
+		 * A method that returns the process-wide pool, the pool is created on the first call.
+		 * @return a reference to the thread pool.
+		 * @throws std::system_error
+		 */
+		static ThreadPool& getInstance()
+		{
+			static ThreadPool pool(std::max(MIN_POOL_THREADS,
+											std::thread::hardware_concurrency()));
+			return pool;
+		}
+
+		/**
+		 * A method that splits the range [first, last) into blocks and calls func(blockFirst,
+		 * blockLast) for every block, the blocks are executed by the pool workers and the calling
+		 * thread. The method returns after all the blocks were executed.
+		 * @param first the first index of the range.
+		 * @param last the past the end index of the range.
+		 * @param func the function to execute on each block.
+		 * @throws std::bad_alloc, after the blocks that were queued were executed.
+		 * @throws any exception thrown by func.
+		 */
+		template<typename Func>
+		void parallelFor(unsigned int first, unsigned int last, const Func &func)
+		{
+			if (first >= last)
+			{
+				return;
+			}
+
+			unsigned int numOfThreads = _workers.size() + 1;
+			unsigned int blockSize = std::max(1u, (last - first) /
+											  (numOfThreads * BLOCKS_PER_THREAD));
+
+			// Case there is no one to share the work with.
+			if (_workers.empty() || (last - first) <= blockSize)
+			{
+				func(first, last);
+				return;
+			}
+
+			// Build the tasks before queueing any of them, so a failure leaves nothing behind.
+			unsigned int numOfBlocks = ((last - first) + blockSize - 1) / blockSize;
+			std::shared_ptr<Job> job = std::make_shared<Job>();
+			job->pending = numOfBlocks;
+			std::vector<Task> tasks;
+			tasks.reserve(numOfBlocks);
+			for (unsigned int blockFirst = first; blockFirst < last; blockFirst += blockSize)
+			{
+				unsigned int blockLast = std::min(last, blockFirst + blockSize);
+				tasks.push_back([job, &func, blockFirst, blockLast]()
+				{
+					try
+					{
+						func(blockFirst, blockLast);
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(job->mutex);
+						if (!job->error)
+						{
+							job->error = std::current_exception();
+						}
+					}
+					_finishTask(*job);
+				});
+			}
+
+			// Spread the blocks over the workers queues round robin, every task is counted under
+			// the lock of its queue so a stealing worker never sees a negative number of queued
+			// tasks.
+			unsigned int numOfQueued = 0;
+			std::exception_ptr queueError;
+			try
+			{
+				for (; numOfQueued < numOfBlocks; numOfQueued++)
+				{
+					WorkerQueue &queue = *_workers[numOfQueued % _workers.size()];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					queue.tasks.push_back(std::move(tasks[numOfQueued]));
+					std::lock_guard<std::mutex> sleepLock(_sleepMutex);
+					_numOfQueuedTasks++;
+				}
+			}
+			catch (...)
+			{
+				// The blocks that were not queued will never be finished, but the queued ones
+				// use func, so they are waited for before the error is thrown.
+				queueError = std::current_exception();
+				std::lock_guard<std::mutex> lock(job->mutex);
+				job->pending -= numOfBlocks - numOfQueued;
+			}
+			_wakeUp.notify_all();
+
+			// Help the workers until there is nothing left to steal, then wait for the job.
+			Task task;
+			while (job->pending > 0 && _steal(_workers.size(), task))
+			{
+				task();
+			}
+			std::unique_lock<std::mutex> lock(job->mutex);
+			job->done.wait(lock, [&job]() { return job->pending == 0; });
+			if (queueError)
+			{
+				std::rethrow_exception(queueError);
+			}
+			if (job->error)
+			{
+				std::rethrow_exception(job->error);
+			}
+		}
+
+		/**
+		 * A method that returns the number of threads that take part in a parallelFor call.
+		 * @return the number of workers plus the calling thread.
+		 */
+		unsigned int size() const noexcept
+		{
+			return _workers.size() + 1;
+		}
+
+		/**
+		 * The destructor, stops and joins all the workers.
+		 */
+		~ThreadPool() noexcept
+		{
+			{
+				std::lock_guard<std::mutex> lock(_sleepMutex);
+				_isStopped = true;
+			}
+			_wakeUp.notify_all();
+			for (std::vector<std::thread>::iterator it = _threads.begin();
+				 it != _threads.end(); ++it)
+			{
+				it->join();
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+	private:
+		typedef std::function<void()> Task; /**< A typedef defines a task of the pool */
+
+		/**
+		 * A struct that holds the state of a single parallelFor call.
+		 */
+		struct Job
+		{
+			std::atomic<unsigned int> pending; /**< The number of blocks not finished yet */
+			std::mutex mutex; /**< A mutex guards the error and the done condition */
+			std::condition_variable done; /**< Notified when the last block is finished */
+			std::exception_ptr error; /**< The first exception thrown by a block */
+		};
+
+		/**
+		 * A struct that holds the tasks queue of a single worker.
+		 */
+		struct WorkerQueue
+		{
+			std::mutex mutex; /**< A mutex guards the tasks queue */
+			std::deque<Task> tasks; /**< The tasks queue of the worker */
+		};
+
+		std::vector<std::unique_ptr<WorkerQueue> > _workers; /**< The queues of the workers */
+		std::vector<std::thread> _threads; /**< The worker threads */
+		std::mutex _sleepMutex; /**< A mutex guards the sleeping of idle workers */
+		std::condition_variable _wakeUp; /**< Notified when new tasks are queued */
+		unsigned int _numOfQueuedTasks; /**< The number of tasks not taken yet */
+		bool _isStopped; /**< True iff the pool is being destroyed */
+
+		/**
+		 * A ctor that creates a pool that runs a job over a given number of threads.
+		 * @param numOfThreads the number of threads including the thread that submits a job.
+		 * @throws std::system_error
+		 */
+		explicit ThreadPool(unsigned int numOfThreads) : _numOfQueuedTasks(0), _isStopped(false)
+		{
+			for (unsigned int i = 1; i < numOfThreads; i++)
+			{
+				_workers.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+			}
+			for (unsigned int i = 0; i < _workers.size(); i++)
+			{
+				_threads.push_back(std::thread(&ThreadPool::_run, this, i));
+			}
+		}
+
+		/**
+		 * A method that marks a task of a job as finished.
+		 * @param job the job the task belongs to.
+		 */
+		static void _finishTask(Job &job) noexcept
+		{
+			// The lock makes sure the waiting thread doesn't miss the notification.
+			std::lock_guard<std::mutex> lock(job.mutex);
+			if (--job.pending == 0)
+			{
+				job.done.notify_all();
+			}
+		}
+
+		/**
+		 * A method that takes a task, first from the back of the given worker queue and then from
+		 * the front of the other workers queues.
+		 * @param self the index of the worker that looks for a task, or the number of workers in
+		 * case the caller is not a worker.
+		 * @param task the task to save to.
+		 * @return true iff a task was found.
+		 */
+		bool _steal(unsigned int self, Task &task)
+		{
+			for (unsigned int i = 0; i < _workers.size(); i++)
+			{
+				unsigned int victim = (self + i) % _workers.size();
+				std::lock_guard<std::mutex> lock(_workers[victim]->mutex);
+				if (_workers[victim]->tasks.empty())
+				{
+					continue;
+				}
+				if (victim == self)
+				{
+					task = std::move(_workers[victim]->tasks.back());
+					_workers[victim]->tasks.pop_back();
+				}
+				else
+				{
+					task = std::move(_workers[victim]->tasks.front());
+					_workers[victim]->tasks.pop_front();
+				}
+				std::lock_guard<std::mutex> sleepLock(_sleepMutex);
+				_numOfQueuedTasks--;
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * The main loop of a worker thread.
+		 * @param self the index of the worker.
+		 */
+		void _run(unsigned int self)
+		{
+			Task task;
+			while (true)
+			{
+				if (_steal(self, task))
+				{
+					task();
+					task = nullptr;
+					continue;
+				}
+				std::unique_lock<std::mutex> lock(_sleepMutex);
+				_wakeUp.wait(lock, [this]() { return _isStopped || _numOfQueuedTasks > 0; });
+				if (_isStopped)
+				{
+					return;
+				}
+			}
+		}
+};
+
+#endif // THREAD_POOL_H_
@@ -0,0 +1,398 @@
+#ifndef VECTOR_KERNELS_H_
+#define VECTOR_KERNELS_H_
+
+#include "Complex.h"
+
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * A template struct of the element-wise kernels that are used to evaluate rows of matrix
+ * expressions. The output may be the same array as one of the inputs.
+ * The generic kernels use the operators of T, the int, double and Complex specializations use
+ * SSE2 or AVX2 instructions, chosen at runtime by the cpu of the machine.
+ */
+template<typename T>
+struct VectorKernels
+{
+	/**
+	 * A function that sums two arrays.
+	 * @param left the left hand cells.
+	 * @param right the right hand cells.
+	 * @param out the array to save the sums at.
+	 * @param count the number of cells.
+	 */
+	static void add(const T *left, const T *right, T *out, unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			out[i] = left[i] + right[i];
+		}
+	}
+
+	/**
+	 * A function that substracts two arrays.
+	 * @param left the left hand cells.
+	 * @param right the right hand cells.
+	 * @param out the array to save the differences at.
+	 * @param count the number of cells.
+	 */
+	static void sub(const T *left, const T *right, T *out, unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			out[i] = left[i] - right[i];
+		}
+	}
+
+	/**
+	 * A function that multiplies an array by a scalar.
+	 * @param scalar the scalar to multiply by.
+	 * @param cells the multiplied cells.
+	 * @param out the array to save the products(scalar * cell) at.
+	 * @param count the number of cells.
+	 */
+	static void scale(const T &scalar, const T *cells, T *out, unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			out[i] = scalar * cells[i];
+		}
+	}
+};
+
+#ifdef VECTOR_KERNELS_X86
+
+/**
+ * A function that tells whether the cpu supports AVX2, the cpu is checked on the first call.
+ * @return true iff AVX2 instructions can be used.
+ */
+inline bool cpuHasAvx2() noexcept
+{
+	static const bool hasAvx2 = []()
+	{
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+	}();
+	return hasAvx2;
+}
+
+// The AVX2 kernels, only called after cpuHasAvx2() returned true.
+
+__attribute__((target("avx2")))
+inline void addDoublesAvx2(const double *left, const double *right, double *out,
+						   unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(left + i),
+												_mm256_loadu_pd(right + i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] + right[i];
+	}
+}
+
+__attribute__((target("avx2")))
+inline void subDoublesAvx2(const double *left, const double *right, double *out,
+						   unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(left + i),
+												_mm256_loadu_pd(right + i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] - right[i];
+	}
+}
+
+__attribute__((target("avx2")))
+inline void scaleDoublesAvx2(double scalar, const double *cells, double *out,
+							 unsigned int count) noexcept
+{
+	const __m256d scalars = _mm256_set1_pd(scalar);
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_mul_pd(scalars, _mm256_loadu_pd(cells + i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = scalar * cells[i];
+	}
+}
+
+__attribute__((target("avx2")))
+inline void addIntsAvx2(const int *left, const int *right, int *out, unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+		__m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(l, r));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] + right[i];
+	}
+}
+
+__attribute__((target("avx2")))
+inline void subIntsAvx2(const int *left, const int *right, int *out, unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+		__m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(l, r));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] - right[i];
+	}
+}
+
+__attribute__((target("avx2")))
+inline void scaleIntsAvx2(int scalar, const int *cells, int *out, unsigned int count) noexcept
+{
+	const __m256i scalars = _mm256_set1_epi32(scalar);
+	unsigned int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_mullo_epi32(scalars, c));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = scalar * cells[i];
+	}
+}
+
+/**
+ * Multiplies interleaved complex numbers(real, imaginary pairs) by a complex scalar, every
+ * product is computed as (sr * r - si * i, sr * i + si * r) like Complex::operator*.
+ */
+__attribute__((target("avx2")))
+inline void scaleComplexAvx2(double scalarReal, double scalarImaginary, const double *cells,
+							 double *out, unsigned int count) noexcept
+{
+	const __m256d reals = _mm256_set1_pd(scalarReal);
+	const __m256d imaginaries = _mm256_set1_pd(scalarImaginary);
+	unsigned int i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		__m256d c = _mm256_loadu_pd(cells + (2 * i));
+		__m256d swapped = _mm256_permute_pd(c, 0x5);
+		_mm256_storeu_pd(out + (2 * i), _mm256_addsub_pd(_mm256_mul_pd(reals, c),
+														 _mm256_mul_pd(imaginaries, swapped)));
+	}
+	for (; i < count; i++)
+	{
+		const double real = cells[2 * i];
+		const double imaginary = cells[(2 * i) + 1];
+		out[2 * i] = (scalarReal * real) - (scalarImaginary * imaginary);
+		out[(2 * i) + 1] = (scalarReal * imaginary) + (scalarImaginary * real);
+	}
+}
+
+// The SSE2 kernels, SSE2 is available on every x86-64 cpu.
+
+inline void addDoublesSse2(const double *left, const double *right, double *out,
+						   unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(left + i), _mm_loadu_pd(right + i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] + right[i];
+	}
+}
+
+inline void subDoublesSse2(const double *left, const double *right, double *out,
+						   unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(left + i), _mm_loadu_pd(right + i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] - right[i];
+	}
+}
+
+inline void scaleDoublesSse2(double scalar, const double *cells, double *out,
+							 unsigned int count) noexcept
+{
+	const __m128d scalars = _mm_set1_pd(scalar);
+	unsigned int i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_mul_pd(scalars, _mm_loadu_pd(cells + i)));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = scalar * cells[i];
+	}
+}
+
+inline void addIntsSse2(const int *left, const int *right, int *out, unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+		__m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(l, r));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] + right[i];
+	}
+}
+
+inline void subIntsSse2(const int *left, const int *right, int *out, unsigned int count) noexcept
+{
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+		__m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi32(l, r));
+	}
+	for (; i < count; i++)
+	{
+		out[i] = left[i] - right[i];
+	}
+}
+
+/**
+ * Like scaleComplexAvx2, SSE2 has no addsub instruction so the sign of the real part of the
+ * second product is flipped and the products are added.
+ */
+inline void scaleComplexSse2(double scalarReal, double scalarImaginary, const double *cells,
+							 double *out, unsigned int count) noexcept
+{
+	const __m128d reals = _mm_set1_pd(scalarReal);
+	const __m128d imaginaries = _mm_set1_pd(scalarImaginary);
+	const __m128d negateReal = _mm_set_pd(0.0, -0.0);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		__m128d c = _mm_loadu_pd(cells + (2 * i));
+		__m128d swapped = _mm_shuffle_pd(c, c, 0x1);
+		__m128d cross = _mm_xor_pd(_mm_mul_pd(imaginaries, swapped), negateReal);
+		_mm_storeu_pd(out + (2 * i), _mm_add_pd(_mm_mul_pd(reals, c), cross));
+	}
+}
+
+/**
+ * The double kernels.
+ */
+template<>
+struct VectorKernels<double>
+{
+	static void add(const double *left, const double *right, double *out, unsigned int count)
+	{
+		cpuHasAvx2() ? addDoublesAvx2(left, right, out, count)
+					 : addDoublesSse2(left, right, out, count);
+	}
+
+	static void sub(const double *left, const double *right, double *out, unsigned int count)
+	{
+		cpuHasAvx2() ? subDoublesAvx2(left, right, out, count)
+					 : subDoublesSse2(left, right, out, count);
+	}
+
+	static void scale(const double &scalar, const double *cells, double *out,
+					  unsigned int count)
+	{
+		cpuHasAvx2() ? scaleDoublesAvx2(scalar, cells, out, count)
+					 : scaleDoublesSse2(scalar, cells, out, count);
+	}
+};
+
+/**
+ * The int kernels, SSE2 has no 32 bit multipication so scale without AVX2 is left to the
+ * compiler.
+ */
+template<>
+struct VectorKernels<int>
+{
+	static void add(const int *left, const int *right, int *out, unsigned int count)
+	{
+		cpuHasAvx2() ? addIntsAvx2(left, right, out, count)
+					 : addIntsSse2(left, right, out, count);
+	}
+
+	static void sub(const int *left, const int *right, int *out, unsigned int count)
+	{
+		cpuHasAvx2() ? subIntsAvx2(left, right, out, count)
+					 : subIntsSse2(left, right, out, count);
+	}
+
+	static void scale(const int &scalar, const int *cells, int *out, unsigned int count)
+	{
+		if (cpuHasAvx2())
+		{
+			scaleIntsAvx2(scalar, cells, out, count);
+			return;
+		}
+		for (unsigned int i = 0; i < count; i++)
+		{
+			out[i] = scalar * cells[i];
+		}
+	}
+};
+
+// The Complex kernels access the cells as pairs of adjacent doubles(real, imaginary).
+static_assert(sizeof(Complex) == 2 * sizeof(double),
+			  "Complex is expected to be laid out as two adjacent doubles");
+
+/**
+ * The Complex kernels, the sum and difference of complex numbers are the sum and difference of
+ * twice as many doubles.
+ */
+template<>
+struct VectorKernels<Complex>
+{
+	static void add(const Complex *left, const Complex *right, Complex *out, unsigned int count)
+	{
+		VectorKernels<double>::add(reinterpret_cast<const double*>(left),
+								   reinterpret_cast<const double*>(right),
+								   reinterpret_cast<double*>(out), 2 * count);
+	}
+
+	static void sub(const Complex *left, const Complex *right, Complex *out, unsigned int count)
+	{
+		VectorKernels<double>::sub(reinterpret_cast<const double*>(left),
+								   reinterpret_cast<const double*>(right),
+								   reinterpret_cast<double*>(out), 2 * count);
+	}
+
+	static void scale(const Complex &scalar, const Complex *cells, Complex *out,
+					  unsigned int count)
+	{
+		const double *scalarParts = reinterpret_cast<const double*>(&scalar);
+		const double *cellsParts = reinterpret_cast<const double*>(cells);
+		double *outParts = reinterpret_cast<double*>(out);
+		cpuHasAvx2() ? scaleComplexAvx2(scalarParts[0], scalarParts[1], cellsParts, outParts, count)
+					 : scaleComplexSse2(scalarParts[0], scalarParts[1], cellsParts, outParts, count);
+	}
+};
+
+#endif // VECTOR_KERNELS_X86
+
+#endif // VECTOR_KERNELS_H_